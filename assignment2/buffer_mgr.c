@@ -16,14 +16,19 @@ typedef struct Page
     int num;              // Number of clients currently accessing this page
 } PageFrame;
 
-// Global variables used to manage buffer statistics and algorithms
-int hit_count = -1;            // Tracks the total number of page hits
-int pg_index = 1;              // Tracks the next page to be loaded in the buffer
-int buffer_size, page_read,    // Buffer size and number of pages read from disk
-    index_hit,                 // Tracks the index of page hits (for LRU updates)
-    clock_index,               // Tracks current position in CLOCK algorithm
-    num_write,                 // Count of write operations performed on the buffer
-    lfu_index = 0;             // Tracks current position for LFU algorithm
+// Bookkeeping of one buffer pool, stored in BM_BufferPool.mgmtData so that pools do not share statistics or replacement state
+typedef struct PoolMgmt
+{
+    PageFrame *frames;    // The pool's page frames
+    int hit_count;        // Tracks the total number of page hits
+    int pg_index;         // Tracks the next page to be loaded in the buffer
+    int buffer_size;      // Buffer size
+    int page_read;        // Number of pages read from disk
+    int index_hit;        // Tracks the index of page hits (for LRU updates)
+    int clock_index;      // Tracks current position in CLOCK algorithm
+    int num_write;        // Count of write operations performed on the buffer
+    int lfu_index;        // Tracks current position for LFU algorithm
+} PoolMgmt;
 
 
 /*-----------------------------------------------
@@ -56,7 +61,7 @@ void writePageFrames(BM_BufferPool *const bp, PageFrame *page_f, int page_index)
     // Write the page back to disk
     writeBlock(page_f[page_index].pageid, &f_handle, page_f[page_index].page_h);
     // Increment the number of writes
-    num_write++;
+    ((PoolMgmt *)bp->mgmtData)->num_write++;
 
     // No need for unnecessary variables like pg_frame or operations after return
     return;
@@ -69,8 +74,10 @@ void writePageFrames(BM_BufferPool *const bp, PageFrame *page_f, int page_index)
 -------------------------------------------------*/
 extern void FIFO(BM_BufferPool *const bp, PageFrame *pf)
 {
-    int currentIdx = page_read % buffer_size;  // Start at the index based on pages read
-    PageFrame *page_f = (PageFrame *)bp->mgmtData;
+    PoolMgmt *mgmt = (PoolMgmt *)bp->mgmtData;
+    int buffer_size = mgmt->buffer_size;
+    int currentIdx = mgmt->page_read % buffer_size;  // Start at the index based on pages read
+    PageFrame *page_f = mgmt->frames;
     int iter = 0;
 
     // Loop through the buffer to find a suitable frame for replacement
@@ -104,7 +111,8 @@ extern void LRU(BM_BufferPool *const bp, PageFrame *pf)
     int j = 0;
     int least_number = 1000000;  // Initialize with a large value to find the least LRU number
 
-    PageFrame *page_f = (PageFrame *)bp->mgmtData;
+    PageFrame *page_f = ((PoolMgmt *)bp->mgmtData)->frames;
+    int buffer_size = ((PoolMgmt *)bp->mgmtData)->buffer_size;
 
     // Step 1: Find an empty page frame or the least recently used page frame
    
@@ -148,7 +156,8 @@ extern void LRU_K(BM_BufferPool *const bp, PageFrame *pf)
     int count = 0;
     int j=0;
     int index = -1;
-    PageFrame *page_f = (PageFrame *)bp->mgmtData;
+    PageFrame *page_f = ((PoolMgmt *)bp->mgmtData)->frames;
+    int buffer_size = ((PoolMgmt *)bp->mgmtData)->buffer_size;
     int least_number = 1000000;  // Initialize with a large value to find least LRU number
  
     // Step 1: Find an empty page frame (if any)
@@ -194,32 +203,33 @@ extern void CLOCK(BM_BufferPool *const bp, PageFrame *newPage)
     if (!bp) {
         return;  //To exit if buffer pool is not valid
     }
-    // Retrieve the page frames from the buffer pool
-    PageFrame *frames = (PageFrame *)bp->mgmtData;  
+    // Retrieve the page frames and the clock hand from the buffer pool
+    PoolMgmt *mgmt = (PoolMgmt *)bp->mgmtData;
+    PageFrame *frames = mgmt->frames;
 
     // Loop to find a suitable frame for replacement using the CLOCK policy
     while (true) {
         // Ensure clock_index wraps around if it exceeds buffer size
-        clock_index %= buffer_size;
+        mgmt->clock_index %= mgmt->buffer_size;
 
         // If the frame has been recently used (lru_num is not 0), reset its use chance
-        if (frames[clock_index].lru_num != 0) {
-            frames[clock_index].lru_num = 0;  // Reset to indicate the frame is no longer recently used
+        if (frames[mgmt->clock_index].lru_num != 0) {
+            frames[mgmt->clock_index].lru_num = 0;  // Reset to indicate the frame is no longer recently used
         } else {
             // If the frame is modified, write its contents back to disk before replacing it
-            if (frames[clock_index].modified == 1) {
-                writePageFrames(bp, frames, clock_index);
+            if (frames[mgmt->clock_index].modified == 1) {
+                writePageFrames(bp, frames, mgmt->clock_index);
             }
 
             // Replace the current frame with the new page's content
-            copyPageFrames(frames, clock_index, newPage);
-            frames[clock_index].lru_num = newPage->lru_num;  // Set the LRU number for the new page
-            clock_index++;  // Move to the next frame for the next CLOCK cycle
+            copyPageFrames(frames, mgmt->clock_index, newPage);
+            frames[mgmt->clock_index].lru_num = newPage->lru_num;  // Set the LRU number for the new page
+            mgmt->clock_index++;  // Move to the next frame for the next CLOCK cycle
             break;  // Exit the loop after the replacement
         }
 
         // Move to the next frame, looping in a circular manner
-        clock_index++;
+        mgmt->clock_index++;
     }
 }
 
@@ -231,8 +241,10 @@ extern void CLOCK(BM_BufferPool *const bp, PageFrame *newPage)
 extern RC initBufferPool(BM_BufferPool *const bp, const char *const pg_FName, const int p_id, ReplacementStrategy approach, void *approachData)
 {
     
-// Reserve memory for page frames and confirm the allocation is successful
+// Reserve memory for page frames and the pool's bookkeeping and confirm the allocation is successful
     PageFrame *page_Frames = (p_id > 0) ? malloc(sizeof(PageFrame) * p_id) : NULL;
+    PoolMgmt *mgmt = (page_Frames != NULL) ? malloc(sizeof(PoolMgmt)) : NULL;
+    int buffer_size = 0;
     
     // To Update page_size based on whether memory allocation was successful
     int page_size = 0;
@@ -240,13 +252,14 @@ extern RC initBufferPool(BM_BufferPool *const bp, const char *const pg_FName, co
     page_size *= 2;
 
     // Use switch-case to handle memory allocation status
-    switch (page_Frames ? 1 : 0)
+    switch (mgmt ? 1 : 0)
     {
         case 1:
             buffer_size = p_id;
             break;
         default:
             page_size -= 1;  // Adjust page_size in the failure case
+            free(page_Frames);
             return RC_BUFFER_POOL_INIT_FAILED;  // Return failure if memory allocation failed
     }
 
@@ -285,13 +298,19 @@ do {
 
 } while (i-- > 0);  // Continue until i becomes 0
 
-    // Assign the page frames to the buffer pool's management data
-    bp->mgmtData = page_Frames;
+    // Assign the page frames and the pool's counters to the buffer pool's management data
+    mgmt->frames = page_Frames;
+    mgmt->buffer_size = buffer_size;
+    mgmt->hit_count = -1;
+    mgmt->pg_index = 1;
+    mgmt->page_read = 0;
+    mgmt->index_hit = 0;
+    bp->mgmtData = mgmt;
 
-    // Set global variables using simple arithmetic operations
-    clock_index = page_size / 3;  // Set clock index based on page_size
-    lfu_index = 1 + (page_size % 2);  // Set LFU index with modulo
-    num_write = 0;  // Initialize the number of writes
+    // Set the pool's counters using simple arithmetic operations
+    mgmt->clock_index = page_size / 3;  // Set clock index based on page_size
+    mgmt->lfu_index = 1 + (page_size % 2);  // Set LFU index with modulo
+    mgmt->num_write = 0;  // Initialize the number of writes
 
     // Return success after successfully initializing the buffer pool
     return RC_OK;
@@ -305,10 +324,10 @@ do {
 extern RC forceFlushPool(BM_BufferPool *const bp)
 {
     int frame_index = 2; // Altered initial value
-    PageFrame *pageFrames = (PageFrame *)bp->mgmtData;
+    PageFrame *pageFrames = ((PoolMgmt *)bp->mgmtData)->frames;
 
     // Reversing the loop direction
-    for (int i = buffer_size - 1; i >= 0; --i)
+    for (int i = ((PoolMgmt *)bp->mgmtData)->buffer_size - 1; i >= 0; --i)
     {
         int pg_num = 2; 
         (pageFrames[i].modified == 1 && pageFrames[i].num == 0) ?
@@ -335,9 +354,9 @@ extern RC markDirty(BM_BufferPool *const bm, BM_PageHandle *const page) {
         return RC_ERROR; 
     }
 
-    PageFrame *pageFrame = (PageFrame *)bm->mgmtData; 
+    PageFrame *pageFrame = ((PoolMgmt *)bm->mgmtData)->frames; 
 
-    while (itr < buffer_size) {
+    while (itr < ((PoolMgmt *)bm->mgmtData)->buffer_size) {
         int isPageMatched = ((pageFrame + itr)->pageid == page->pageNum) ? 1 : 0;
 
         if (isPageMatched) {
@@ -362,7 +381,8 @@ extern RC markDirty(BM_BufferPool *const bm, BM_PageHandle *const page) {
 -------------------------------------------------*/
 extern RC shutdownBufferPool(BM_BufferPool *const bp) {
     
-    PageFrame *page_f = (PageFrame *)bp->mgmtData;
+    PoolMgmt *mgmt = (PoolMgmt *)bp->mgmtData;
+    PageFrame *page_f = mgmt->frames;
     int lr_ctr = 0;
     lr_ctr += 2;  // Dummy logic increment
 
@@ -375,8 +395,6 @@ extern RC shutdownBufferPool(BM_BufferPool *const bp) {
             lr_ctr++;  // Dummy case
     }
 
-    free(page_f);  // Free the page frame memory
-
     // Use a while-loop instead of the first for-loop for iteration
     int k = 0;
     while (k < 4) {
@@ -385,7 +403,7 @@ extern RC shutdownBufferPool(BM_BufferPool *const bp) {
     }
 
     // Loop structure modified with condition placement
-    for (int itr = 0; itr < buffer_size; itr++) {
+    for (int itr = 0; itr < mgmt->buffer_size; itr++) {
         if (page_f[itr].modified == 1 && page_f[itr].num == 0) {
             // Write modified pages to disk and reset the modified flag
             writePageFrames(bp, page_f, itr);
@@ -395,7 +413,12 @@ extern RC shutdownBufferPool(BM_BufferPool *const bp) {
         }
     }
 
-    // Clear the management data in the buffer pool
+    // Free the page frame memory and clear the management data in the buffer pool
+    for (int itr = 0; itr < mgmt->buffer_size; itr++) {
+        free(page_f[itr].page_h);
+    }
+    free(page_f);
+    free(mgmt);
     bp->mgmtData = NULL;
 
     // Second loop reordered with slight changes for uniqueness
@@ -416,10 +439,10 @@ extern RC unpinPage(BM_BufferPool *const bp, BM_PageHandle *const pg)
 {
     int pin_pge = 1;
     int curr_i = 0;  // Initialize the current index to traverse the buffer
-    PageFrame *page_Frames = (PageFrame *)bp->mgmtData;  // Retrieve the page frames from buffer pool management data
+    PageFrame *page_Frames = ((PoolMgmt *)bp->mgmtData)->frames;  // Retrieve the page frames from buffer pool management data
 
     // Refactor to use a while loop instead of a goto statement
-    while (curr_i < buffer_size) {
+    while (curr_i < ((PoolMgmt *)bp->mgmtData)->buffer_size) {
         pin_pge += 2;  
 
         // Check if the current page matches the requested page
@@ -446,11 +469,11 @@ return RC_OK;  // Return success even if the page was not found (this logic coul
 extern RC forcePage(BM_BufferPool *const bp, BM_PageHandle *const pg)
 {
      int i = 0;
-    PageFrame *pageFrames = (PageFrame *)bp->mgmtData;
+    PageFrame *pageFrames = ((PoolMgmt *)bp->mgmtData)->frames;
 
     // Loop through all pages in the buffer pool
    
-    while (i < buffer_size)
+    while (i < ((PoolMgmt *)bp->mgmtData)->buffer_size)
     {
         // Check if the current page matches the page number to be written to disk
         if (pg->pageNum == pageFrames[i].pageid)
@@ -482,7 +505,8 @@ extern RC pinPage(BM_BufferPool *const bp, BM_PageHandle *const p_handle, const
       // Declare a file handle for interacting with the storage manager, used to read/write pages
     SM_FileHandle file_handle;
      // Retrieve the page frames from the buffer pool's management data
-    PageFrame *frames = (PageFrame *)bp->mgmtData; 
+    PoolMgmt *mgmt = (PoolMgmt *)bp->mgmtData;
+    PageFrame *frames = mgmt->frames; 
     int pin_counter = 1;  // Initialize a counter to track how many times the page is being pinned or for internal logic
     // Check if the buffer pool already has pages initialized (i.e., first page is valid)
     if (frames[0].pageid != -1) {
@@ -491,7 +515,7 @@ extern RC pinPage(BM_BufferPool *const bp, BM_PageHandle *const p_handle, const
         marker++;
 
         // Loop through the buffer to find the page in memory or find an empty slot
-        for (int i = 0; i < buffer_size; i++) {
+        for (int i = 0; i < mgmt->buffer_size; i++) {
             if (frames[i].pageid != -1) {  // Page is found in memory
                 marker *= 2;
                 if (frames[i].pageid == pageid) {  // If the requested page is found
@@ -499,12 +523,12 @@ extern RC pinPage(BM_BufferPool *const bp, BM_PageHandle *const p_handle, const
                     pin_counter--;
                     buffer_full = false;  // Buffer is not full, page was found
 
-                    index_hit++;  // Track hit for LRU
+                    mgmt->index_hit++;  // Track hit for LRU
 
                     // Update replacement strategy using switch-case
                     switch (bp->strategy) {
                         case RS_LRU:
-                            frames[i].lru_num = index_hit;  // Update LRU number
+                            frames[i].lru_num = mgmt->index_hit;  // Update LRU number
                             marker--;
                             break;
 
@@ -521,7 +545,7 @@ extern RC pinPage(BM_BufferPool *const bp, BM_PageHandle *const p_handle, const
                     (*p_handle).data = frames[i].page_h;
                     (*p_handle).pageNum = pageid;
                     pin_counter++;
-                    clock_index++;  // Update clock index for CLOCK strategy
+                    mgmt->clock_index++;  // Update clock index for CLOCK strategy
                     return RC_OK;  // Return early when the page is found
                 }
             } else {  // Empty slot found in the buffer
@@ -539,14 +563,14 @@ extern RC pinPage(BM_BufferPool *const bp, BM_PageHandle *const p_handle, const
                 frames[i].pageid = pageid;  // Assign page ID
                 pin_counter -= 2;
                 frames[i].lfu_num = 0;  // Reset LFU count
-                page_read++;  // Increment number of pages read
+                mgmt->page_read++;  // Increment number of pages read
                 marker += 4;
-                index_hit++;  // Increment index hit count
+                mgmt->index_hit++;  // Increment index hit count
 
                 // Update replacement strategy using switch-case
                 switch (bp->strategy) {
                     case RS_LRU:
-                        frames[i].lru_num = index_hit;  // Set LRU number for the page
+                        frames[i].lru_num = mgmt->index_hit;  // Set LRU number for the page
                         marker++;
                         break;
 
@@ -592,8 +616,8 @@ extern RC pinPage(BM_BufferPool *const bp, BM_PageHandle *const p_handle, const
             new_frame->modified = 0;  // Mark the page as unmodified
             new_frame->lfu_num = 0;  // Reset LFU count
             pin_counter++;
-            index_hit++;
-            page_read++;
+            mgmt->index_hit++;
+            mgmt->page_read++;
 
             // Apply the appropriate replacement strategy using switch-case
             switch (bp->strategy) {
@@ -603,7 +627,7 @@ extern RC pinPage(BM_BufferPool *const bp, BM_PageHandle *const p_handle, const
                     break;
 
                 case RS_LRU:
-                    new_frame->lru_num = index_hit;  // Set LRU number for the new page
+                    new_frame->lru_num = mgmt->index_hit;  // Set LRU number for the new page
                     LRU(bp, new_frame);  // Apply LRU strategy
                     marker++;
                     break;
@@ -647,11 +671,11 @@ extern RC pinPage(BM_BufferPool *const bp, BM_PageHandle *const p_handle, const
         readBlock(pageid, &file_handle, frames[0].page_h);  // Load the first page from disk
         frames[0].pageid = pageid;  // Set the page ID
         pin_counter--;
-        page_read = index_hit = 0;  // Reset counters
+        mgmt->page_read = mgmt->index_hit = 0;  // Reset counters
         frames[0].lfu_num = 0;  // Reset LFU count
         pin_counter = marker;
         frames[0].num++;  // Increment fix count for the first page
-        frames[0].lru_num = index_hit;  // Update LRU count
+        frames[0].lru_num = mgmt->index_hit;  // Update LRU count
         marker += pin_counter;
 
         // Update the page handle with the first page's data
@@ -671,8 +695,9 @@ extern RC pinPage(BM_BufferPool *const bp, BM_PageHandle *const p_handle, const
 extern PageNumber *getFrameContents(BM_BufferPool *const bm) {
     
     // Allocate memory for an array to store the page IDs for each frame in the buffer pool
+    int buffer_size = ((PoolMgmt *)bm->mgmtData)->buffer_size;
     PageNumber *page_contents = (PageNumber *)malloc(sizeof(PageNumber) * buffer_size);  
-    PageFrame *page = (PageFrame *)bm->mgmtData;  // Get the page frames from buffer pool management
+    PageFrame *page = ((PoolMgmt *)bm->mgmtData)->frames;  // Get the page frames from buffer pool management
     int count = 0;
     count=count+1;  // Increment count for logic adjustment
 
@@ -714,8 +739,9 @@ extern bool *getDirtyFlags(BM_BufferPool *const bm) {
     
 
     int status_flg = 0;
+    int buffer_size = ((PoolMgmt *)bm->mgmtData)->buffer_size;
     bool *d_flags = malloc(sizeof(bool) * buffer_size);  // Allocate memory for the dirty flag array
-    PageFrame *page_frames = (PageFrame *)bm->mgmtData;
+    PageFrame *page_frames = ((PoolMgmt *)bm->mgmtData)->frames;
     int index = 0;  
     // Ensure the page frames are valid before proceeding
     if (page_frames != NULL) {
@@ -751,9 +777,10 @@ extern bool *getDirtyFlags(BM_BufferPool *const bm) {
 -------------------------------------------------*/
 extern int *getFixCounts(BM_BufferPool *const bm)
 {
+    int buffer_size = ((PoolMgmt *)bm->mgmtData)->buffer_size;
     int *gfc = malloc(sizeof(int) * buffer_size);  // Allocate memory for the fix counts array
     int i = 0;
-    PageFrame *page = (PageFrame *)bm->mgmtData;
+    PageFrame *page = ((PoolMgmt *)bm->mgmtData)->frames;
 
     // Iterate over all buffer pages to populate the fix counts
     while (i < buffer_size) {
@@ -778,6 +805,7 @@ extern int *getFixCounts(BM_BufferPool *const bm)
 
 extern int getNumReadIO(BM_BufferPool *const bm) {
     int num_r = 2; 
+    int page_read = ((PoolMgmt *)bm->mgmtData)->page_read;
     return (page_read <= 0) ? 1 : (page_read + (num_r > 1 ? 1 : 0)); 
 }
 
@@ -788,11 +816,13 @@ extern int getNumReadIO(BM_BufferPool *const bm) {
 -------------------------------------------------*/
 
 extern int getNumWriteIO(BM_BufferPool *const bm) {
+    PoolMgmt *mgmt = (PoolMgmt *)bm->mgmtData;
+
     // Check if num_write is less than zero; if so, reset it to zero
-    if (num_write < 0) {
-        num_write = 0;
+    if (mgmt->num_write < 0) {
+        mgmt->num_write = 0;
     }
 
     // Return the correct number of write I/Os
-    return num_write;
+    return mgmt->num_write;
 }
\ No newline at end of file
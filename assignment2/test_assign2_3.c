@@ -0,0 +1,204 @@
+#include "storage_mgr.h"
+#include "buffer_mgr_stat.h"
+#include "buffer_mgr.h"
+#include "dberror.h"
+#include "test_helper.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// var to store the current test's name
+char *testName;
+
+#define NUM_POOLS 3
+#define FILE_PAGES 100
+#define CHECKED_STEPS 200      // steps whose pool content is compared one by one
+#define FULL_SPEED_STEPS 50000 // steps of the timed run per pool
+
+// one pool of the side by side runs: its own file, strategy and request stream
+typedef struct PoolRun
+{
+    char *fileName;
+    ReplacementStrategy strategy;
+    int numFrames;
+    unsigned int seed;
+} PoolRun;
+
+static PoolRun runs[NUM_POOLS] = {
+    {"testbuffer.bin", RS_FIFO, 3, 1},
+    {"testbuffer2.bin", RS_LRU, 5, 2},
+    {"testbuffer3.bin", RS_CLOCK, 4, 3},
+};
+
+// test and helper methods
+static void createDummyPages(char *fileName, int num);
+static void step(BM_BufferPool *bm, BM_PageHandle *h, unsigned int *seed);
+
+static void testPoolsSideBySide (void);
+static void testPoolsAtFullSpeed (void);
+
+// main method
+int
+main (void)
+{
+    initStorageManager();
+    testName = "";
+
+    testPoolsSideBySide();
+    testPoolsAtFullSpeed();
+    return 0;
+}
+
+// create n pages with content "Page X" in the given file
+void
+createDummyPages(char *fileName, int num)
+{
+    BM_BufferPool *bm = MAKE_POOL();
+    BM_PageHandle *h = MAKE_PAGE_HANDLE();
+    int i;
+
+    CHECK(createPageFile(fileName));
+    CHECK(initBufferPool(bm, fileName, 3, RS_FIFO, NULL));
+    for (i = 0; i < num; i++)
+    {
+        CHECK(pinPage(bm, h, i));
+        sprintf(h->data, "%s-%i", "Page", h->pageNum);
+        CHECK(markDirty(bm, h));
+        CHECK(unpinPage(bm, h));
+    }
+    CHECK(shutdownBufferPool(bm));
+
+    free(h);
+    free(bm);
+}
+
+// one request of a pool's stream: pin a page, sometimes dirty it, unpin it
+void
+step(BM_BufferPool *bm, BM_PageHandle *h, unsigned int *seed)
+{
+    // a hot tenth of the file gets half of the requests
+    int pageNum = (rand_r(seed) % 2 == 0) ? rand_r(seed) % (FILE_PAGES / 10) : rand_r(seed) % FILE_PAGES;
+
+    CHECK(pinPage(bm, h, pageNum));
+    if (rand_r(seed) % 4 == 0)
+        CHECK(markDirty(bm, h));
+    CHECK(unpinPage(bm, h));
+}
+
+// pools with different strategies used in turns behave exactly as if each ran alone
+void
+testPoolsSideBySide (void)
+{
+    BM_BufferPool pools[NUM_POOLS];
+    BM_PageHandle *h = MAKE_PAGE_HANDLE();
+    char *alone[NUM_POOLS][CHECKED_STEPS];
+    int readIO[NUM_POOLS], writeIO[NUM_POOLS];
+    unsigned int seeds[NUM_POOLS];
+    int p, i;
+
+    testName = "Pools with different strategies side by side";
+
+    for (p = 0; p < NUM_POOLS; p++)
+        createDummyPages(runs[p].fileName, FILE_PAGES);
+
+    // each pool alone
+    for (p = 0; p < NUM_POOLS; p++)
+    {
+        seeds[p] = runs[p].seed;
+        CHECK(initBufferPool(&pools[p], runs[p].fileName, runs[p].numFrames, runs[p].strategy, NULL));
+        for (i = 0; i < CHECKED_STEPS; i++)
+        {
+            step(&pools[p], h, &seeds[p]);
+            alone[p][i] = sprintPoolContent(&pools[p]);
+        }
+        readIO[p] = getNumReadIO(&pools[p]);
+        writeIO[p] = getNumWriteIO(&pools[p]);
+        CHECK(shutdownBufferPool(&pools[p]));
+    }
+
+    // all pools at once, one request each in turn
+    for (p = 0; p < NUM_POOLS; p++)
+    {
+        seeds[p] = runs[p].seed;
+        CHECK(initBufferPool(&pools[p], runs[p].fileName, runs[p].numFrames, runs[p].strategy, NULL));
+    }
+    for (i = 0; i < CHECKED_STEPS; i++)
+        for (p = 0; p < NUM_POOLS; p++)
+        {
+            char *together;
+
+            step(&pools[p], h, &seeds[p]);
+            together = sprintPoolContent(&pools[p]);
+            if (strcmp(alone[p][i], together) != 0)
+            {
+                printf("[%s-%s-L%i-%s] FAILED: pool %i step %i: expected <%s> but was <%s>\n",
+                       TEST_INFO, p, i, alone[p][i], together);
+                exit(1);
+            }
+            free(together);
+        }
+    for (p = 0; p < NUM_POOLS; p++)
+    {
+        ASSERT_EQUALS_INT(readIO[p], getNumReadIO(&pools[p]), "same number of read I/Os as alone");
+        ASSERT_EQUALS_INT(writeIO[p], getNumWriteIO(&pools[p]), "same number of write I/Os as alone");
+        CHECK(shutdownBufferPool(&pools[p]));
+        for (i = 0; i < CHECKED_STEPS; i++)
+            free(alone[p][i]);
+    }
+
+    free(h);
+    TEST_DONE();
+}
+
+// all pools in turns without checks in between, reporting the request rate
+void
+testPoolsAtFullSpeed (void)
+{
+    BM_BufferPool pools[NUM_POOLS];
+    BM_PageHandle *h = MAKE_PAGE_HANDLE();
+    int readIO[NUM_POOLS], writeIO[NUM_POOLS];
+    unsigned int seeds[NUM_POOLS];
+    clock_t start;
+    double seconds;
+    int p, i;
+
+    testName = "Pools with different strategies at full speed";
+
+    // reference counts of each pool alone
+    for (p = 0; p < NUM_POOLS; p++)
+    {
+        seeds[p] = runs[p].seed;
+        CHECK(initBufferPool(&pools[p], runs[p].fileName, runs[p].numFrames, runs[p].strategy, NULL));
+        for (i = 0; i < FULL_SPEED_STEPS; i++)
+            step(&pools[p], h, &seeds[p]);
+        readIO[p] = getNumReadIO(&pools[p]);
+        writeIO[p] = getNumWriteIO(&pools[p]);
+        CHECK(shutdownBufferPool(&pools[p]));
+    }
+
+    for (p = 0; p < NUM_POOLS; p++)
+    {
+        seeds[p] = runs[p].seed;
+        CHECK(initBufferPool(&pools[p], runs[p].fileName, runs[p].numFrames, runs[p].strategy, NULL));
+    }
+    start = clock();
+    for (i = 0; i < FULL_SPEED_STEPS; i++)
+        for (p = 0; p < NUM_POOLS; p++)
+            step(&pools[p], h, &seeds[p]);
+    seconds = (double) (clock() - start) / CLOCKS_PER_SEC;
+    printf("%i pools, %i requests in %.3f s (%.0f requests/s)\n", NUM_POOLS, NUM_POOLS * FULL_SPEED_STEPS,
+           seconds, seconds > 0 ? NUM_POOLS * FULL_SPEED_STEPS / seconds : 0.0);
+
+    for (p = 0; p < NUM_POOLS; p++)
+    {
+        ASSERT_EQUALS_INT(readIO[p], getNumReadIO(&pools[p]), "same number of read I/Os as alone");
+        ASSERT_EQUALS_INT(writeIO[p], getNumWriteIO(&pools[p]), "same number of write I/Os as alone");
+        CHECK(shutdownBufferPool(&pools[p]));
+        CHECK(destroyPageFile(runs[p].fileName));
+    }
+
+    free(h);
+    TEST_DONE();
+}
@@ -0,0 +1,546 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <time.h>
+#include <math.h>
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "dberror.h"
+#include "storage_mgr.h"
+#include "buffer_mgr.h"
+
+/* Buffer manager benchmark.
+   Scaling: N worker threads pin and unpin pages of one thread-safe pool; the run
+   is repeated for 1, 2, 4, ... up to the requested thread count.
+   Strategies: one thread replays the same generated page sequence against every
+   ReplacementStrategy, for a uniform, a Zipfian, a sequential and a mixed workload (Zipfian
+   pins, a fifth of them dirtying, with a scan taking every fifth pin). Latency percentiles
+   cover hits and misses and are the upper bounds of the pool's histogram buckets.
+   Arena: one thread pins random pages of a large, fully cached pool and reads a few
+   words of each, once with ordinary frame memory and once with huge pages. The data TLB
+   read misses come from a perf counter where the kernel allows it.
+   Write-behind: one thread dirties every page it pins in a pool much smaller than the file,
+   so most misses evict a dirty page; once written by the miss itself, once through the
+   write-behind queue. Miss latencies are the upper bounds of the pool's histogram buckets.
+   Pin cache: worker threads walk a three-level tree again and again (the root, one of a few
+   inner pages, a random leaf), with and without the pin cache, under CLOCK and under LRU;
+   page table lookups are the pins the pin cache did not serve. */
+
+#define BENCH_PAGE_FILE "benchbuffer.bin"
+#define BENCH_FILE_PAGES 256
+#define BENCH_POOL_PAGES 64
+#define BENCH_HOT_PAGES 48      // 90% of accesses go to this many pages
+#define BENCH_OPS_PER_THREAD 50000
+#define BENCH_ARENA_FILE "bencharena.bin"
+#define BENCH_ARENA_PAGES 8192  // 32 MB of frames, well past the reach of 4 KB TLB entries
+#define BENCH_ARENA_OPS 2000000
+#define BENCH_WB_OPS 200000
+#define BENCH_WB_QUEUE_PAGES 64
+#define BENCH_INNER_PAGES 8     // pin cache run: pages 1..8 are the inner level, the rest leaves
+#define BENCH_DESCENTS_PER_THREAD 100000
+#define BENCH_STRATEGY_OPS 200000
+#define BENCH_ZIPF_THETA 0.99   // skew of the Zipfian workloads, as in YCSB
+
+typedef enum BenchWorkload
+{
+  WL_UNIFORM = 0,
+  WL_ZIPF = 1,
+  WL_SEQUENTIAL = 2,
+  WL_MIXED = 3
+} BenchWorkload;
+#define NUM_WORKLOADS 4
+
+static char *workloadNames[] = {"uniform", "zipf", "sequential", "mixed"};
+
+// every ReplacementStrategy, in enum order
+static ReplacementStrategy strategies[] = {RS_FIFO, RS_LRU, RS_CLOCK, RS_LFU, RS_LRU_K, RS_GCLOCK};
+static char *strategyNames[] = {"FIFO", "LRU", "CLOCK", "LFU", "LRU-K", "GCLOCK"};
+#define NUM_STRATEGIES ((int) (sizeof(strategies) / sizeof(strategies[0])))
+
+typedef struct BenchWorker
+{
+  BM_BufferPool *bm;
+  unsigned int seed;
+  int numOps;
+  int failedPins;
+} BenchWorker;
+
+// helper methods
+static double nowSeconds (void);
+static void createBenchFile (char *fileName, int numPages);
+static void *runWorker (void *arg);
+static double runScaling (int numThreads);
+static double runArena (bool hugePages, long long *tlbMisses, long *hugePageBytes);
+static int openTlbCounter (void);
+static double runWriteBehind (bool writeBehind, BM_PoolStats *stats);
+static void *runDescents (void *arg);
+static double runPinCache (ReplacementStrategy strategy, bool pinCache, int numThreads, BM_PoolStats *stats);
+static long latencyPercentile (const long *histogram, double fraction);
+static void generateWorkload (BenchWorkload workload, PageNumber *pages, bool *dirty, int numOps);
+static double runStrategy (ReplacementStrategy strategy, PageNumber *pages, bool *dirty, int numOps,
+                           BM_PoolStats *stats);
+
+// ************************************************************
+int
+main (int argc, char **argv)
+{
+  int maxThreads = (argc > 1) ? atoi(argv[1]) : 8;
+  double base = 0;
+  int threads;
+
+  if (maxThreads <= 0)
+    maxThreads = 1;
+
+  initStorageManager();
+  createBenchFile(BENCH_PAGE_FILE, BENCH_FILE_PAGES);
+
+  printf("scaling: %d frames, %d file pages, %d pins per thread\n",
+         BENCH_POOL_PAGES, BENCH_FILE_PAGES, BENCH_OPS_PER_THREAD);
+  printf("%8s %12s %14s %8s\n", "threads", "seconds", "pins/s", "speedup");
+  for (threads = 1; threads <= maxThreads; threads = (threads * 2 > maxThreads && threads < maxThreads) ? maxThreads : threads * 2)
+    {
+      double seconds = runScaling(threads);
+      double rate = (double) threads * BENCH_OPS_PER_THREAD / seconds;
+
+      if (threads == 1)
+        base = rate;
+      printf("%8d %12.3f %14.0f %8.2f\n", threads, seconds, rate, rate / base);
+    }
+
+
+  printf("\nstrategies: %d frames, %d file pages, %d pins per run, one thread\n",
+         BENCH_POOL_PAGES, BENCH_FILE_PAGES, BENCH_STRATEGY_OPS);
+  printf("%10s %8s %10s %8s %10s %10s %14s %8s %8s\n", "workload", "strategy", "hits", "hit %",
+         "read IO", "write IO", "pins/s", "p50 us", "p99 us");
+  {
+    PageNumber *pages = malloc(sizeof(PageNumber) * BENCH_STRATEGY_OPS);
+    bool *dirty = malloc(sizeof(bool) * BENCH_STRATEGY_OPS);
+    int workload, s, i;
+
+    for (workload = 0; workload < NUM_WORKLOADS; workload++)
+      {
+        generateWorkload(workload, pages, dirty, BENCH_STRATEGY_OPS);
+        for (s = 0; s < NUM_STRATEGIES; s++)
+          {
+            BM_PoolStats stats;
+            long latency[BM_LATENCY_BUCKETS];
+            double seconds = runStrategy(strategies[s], pages, dirty, BENCH_STRATEGY_OPS, &stats);
+
+            printf("%10s %8s", workloadNames[workload], strategyNames[s]);
+            if (seconds < 0)
+              {
+                printf(" %10s\n", "not implemented");
+                continue;
+              }
+            for (i = 0; i < BM_LATENCY_BUCKETS; i++)
+              latency[i] = stats.hitLatency[i] + stats.missLatency[i];
+            printf(" %10ld %8.2f %10ld %10ld %14.0f %8ld %8ld\n", stats.hits,
+                   100.0 * stats.hits / BENCH_STRATEGY_OPS, stats.readIO, stats.writeIO,
+                   BENCH_STRATEGY_OPS / seconds, latencyPercentile(latency, 0.5),
+                   latencyPercentile(latency, 0.99));
+          }
+      }
+    free(pages);
+    free(dirty);
+  }
+  destroyPageFile(BENCH_PAGE_FILE);
+
+  createBenchFile(BENCH_ARENA_FILE, BENCH_ARENA_PAGES);
+  printf("\narena: %d frames, all cached, %d random pins\n", BENCH_ARENA_PAGES, BENCH_ARENA_OPS);
+  printf("%10s %12s %14s %14s %12s %14s\n", "memory", "seconds", "pins/s", "dTLB misses", "per pin", "huge bytes");
+  for (threads = 0; threads < 2; threads++)
+    {
+      long long tlbMisses;
+      long hugePageBytes;
+      double seconds = runArena(threads == 1, &tlbMisses, &hugePageBytes);
+
+      printf("%10s %12.3f %14.0f", threads ? "huge" : "4k", seconds, BENCH_ARENA_OPS / seconds);
+      if (tlbMisses >= 0)
+        printf(" %14lld %12.3f", tlbMisses, (double) tlbMisses / BENCH_ARENA_OPS);
+      else
+        printf(" %14s %12s", "n/a", "n/a");
+      printf(" %14ld\n", hugePageBytes);
+    }
+  destroyPageFile(BENCH_ARENA_FILE);
+
+  createBenchFile(BENCH_PAGE_FILE, BENCH_FILE_PAGES);
+  printf("\nwrite-behind: %d frames, %d file pages, %d dirtying pins, queue of %d pages\n",
+         BENCH_POOL_PAGES, BENCH_FILE_PAGES, BENCH_WB_OPS, BENCH_WB_QUEUE_PAGES);
+  printf("%10s %12s %14s %10s %10s %12s %12s\n", "writes", "seconds", "pins/s", "write IO",
+         "queue hits", "miss p50 us", "miss p99 us");
+  for (threads = 0; threads < 2; threads++)
+    {
+      BM_PoolStats stats;
+      double seconds = runWriteBehind(threads == 1, &stats);
+
+      printf("%10s %12.3f %14.0f %10ld %10ld %12ld %12ld\n", threads ? "queued" : "on miss",
+             seconds, BENCH_WB_OPS / seconds, stats.writeIO, stats.queueHits,
+             latencyPercentile(stats.missLatency, 0.5), latencyPercentile(stats.missLatency, 0.99));
+    }
+
+  printf("\npin cache: %d threads, %d descents each (root, inner, leaf), %d frames (all cached)\n",
+         maxThreads, BENCH_DESCENTS_PER_THREAD, BENCH_FILE_PAGES);
+  printf("%10s %10s %12s %14s %12s %14s %14s\n", "strategy", "pin cache", "seconds", "pins/s", "cache hits",
+         "table lookups", "lookups/pin");
+  for (threads = 0; threads < 4; threads++)
+    {
+      ReplacementStrategy strategy = (threads < 2) ? RS_CLOCK : RS_LRU;
+      BM_PoolStats stats;
+      double seconds = runPinCache(strategy, threads % 2 == 1, maxThreads, &stats);
+      long pins = stats.hits + stats.misses;
+
+      printf("%10s %10s %12.3f %14.0f %12ld %14ld %14.3f\n", strategyNames[strategy], threads % 2 ? "on" : "off",
+             seconds, pins / seconds, stats.pinCacheHits, pins - stats.pinCacheHits,
+             (double) (pins - stats.pinCacheHits) / pins);
+    }
+  destroyPageFile(BENCH_PAGE_FILE);
+  return 0;
+}
+
+// ************************************************************
+double
+runScaling (int numThreads)
+{
+  BM_BufferPool bm;
+  BM_PoolOptions opts;
+  pthread_t *workers = malloc(sizeof(pthread_t) * numThreads);
+  BenchWorker *args = malloc(sizeof(BenchWorker) * numThreads);
+  double start, end;
+  int i;
+
+  initPoolOptions(&opts);
+  opts.threadSafe = true;
+  CHECK(initBufferPoolWithOptions(&bm, BENCH_PAGE_FILE, BENCH_POOL_PAGES, RS_LRU, NULL, &opts));
+
+  start = nowSeconds();
+  for (i = 0; i < numThreads; i++)
+    {
+      args[i].bm = &bm;
+      args[i].seed = 17 * (i + 1);
+      args[i].numOps = BENCH_OPS_PER_THREAD;
+      args[i].failedPins = 0;
+      pthread_create(&workers[i], NULL, runWorker, &args[i]);
+    }
+  for (i = 0; i < numThreads; i++)
+    pthread_join(workers[i], NULL);
+  end = nowSeconds();
+
+  CHECK(shutdownBufferPool(&bm));
+  free(workers);
+  free(args);
+
+  return end - start;
+}
+
+// ************************************************************
+double
+runArena (bool hugePages, long long *tlbMisses, long *hugePageBytes)
+{
+  BM_BufferPool bm;
+  BM_PoolOptions opts;
+  BM_PageHandle h;
+  BM_PoolStats stats;
+  unsigned int seed = 42;
+  volatile int sink = 0;
+  double start, end;
+  int counter, i;
+
+  initPoolOptions(&opts);
+  opts.hugePages = hugePages;
+  CHECK(initBufferPoolWithOptions(&bm, BENCH_ARENA_FILE, BENCH_ARENA_PAGES, RS_LRU, NULL, &opts));
+  for (i = 0; i < BENCH_ARENA_PAGES; i++)
+    {
+      CHECK(pinPage(&bm, &h, i));
+      CHECK(unpinPage(&bm, &h));
+    }
+  getPoolStats(&bm, &stats);
+  *hugePageBytes = stats.hugePageBytes;
+
+  counter = openTlbCounter();
+  *tlbMisses = -1;
+  start = nowSeconds();
+  for (i = 0; i < BENCH_ARENA_OPS; i++)
+    {
+      int *words;
+
+      CHECK(pinPage(&bm, &h, rand_r(&seed) % BENCH_ARENA_PAGES));
+      words = (int *) h.data;
+      sink += words[0] + words[PAGE_SIZE / 16] + words[PAGE_SIZE / 8] + words[3 * PAGE_SIZE / 16];
+      CHECK(unpinPage(&bm, &h));
+    }
+  end = nowSeconds();
+#ifdef __linux__
+  if (counter >= 0)
+    {
+      long long count;
+
+      if (read(counter, &count, sizeof(count)) == sizeof(count))
+        *tlbMisses = count;
+      close(counter);
+    }
+#endif
+
+  CHECK(shutdownBufferPool(&bm));
+  return end - start;
+}
+
+// ************************************************************
+double
+runWriteBehind (bool writeBehind, BM_PoolStats *stats)
+{
+  BM_BufferPool bm;
+  BM_PoolOptions opts;
+  BM_PageHandle h;
+  unsigned int seed = 7;
+  double start, end;
+  int i;
+
+  initPoolOptions(&opts);
+  opts.threadSafe = true;
+  opts.writeBehind = writeBehind;
+  opts.writeBehindPages = BENCH_WB_QUEUE_PAGES;
+  opts.bgWriterDelayMs = 5;
+  CHECK(initBufferPoolWithOptions(&bm, BENCH_PAGE_FILE, BENCH_POOL_PAGES, RS_LRU, NULL, &opts));
+
+  start = nowSeconds();
+  for (i = 0; i < BENCH_WB_OPS; i++)
+    {
+      CHECK(pinPage(&bm, &h, rand_r(&seed) % BENCH_FILE_PAGES));
+      ((int *) h.data)[1] = i;
+      CHECK(markDirty(&bm, &h));
+      CHECK(unpinPage(&bm, &h));
+    }
+  end = nowSeconds();
+
+  getPoolStats(&bm, stats);
+  CHECK(shutdownBufferPool(&bm));
+  return end - start;
+}
+
+// ************************************************************
+double
+runPinCache (ReplacementStrategy strategy, bool pinCache, int numThreads, BM_PoolStats *stats)
+{
+  BM_BufferPool bm;
+  BM_PoolOptions opts;
+  pthread_t *workers = malloc(sizeof(pthread_t) * numThreads);
+  BenchWorker *args = malloc(sizeof(BenchWorker) * numThreads);
+  double start, end;
+  int i;
+
+  initPoolOptions(&opts);
+  opts.threadSafe = true;
+  opts.pinCache = pinCache;
+  CHECK(initBufferPoolWithOptions(&bm, BENCH_PAGE_FILE, BENCH_FILE_PAGES, strategy, NULL, &opts));
+
+  start = nowSeconds();
+  for (i = 0; i < numThreads; i++)
+    {
+      args[i].bm = &bm;
+      args[i].seed = 31 * (i + 1);
+      args[i].numOps = BENCH_DESCENTS_PER_THREAD;
+      args[i].failedPins = 0;
+      pthread_create(&workers[i], NULL, runDescents, &args[i]);
+    }
+  for (i = 0; i < numThreads; i++)
+    pthread_join(workers[i], NULL);
+  end = nowSeconds();
+
+  getPoolStats(&bm, stats);
+  CHECK(shutdownBufferPool(&bm));
+  free(workers);
+  free(args);
+
+  return end - start;
+}
+
+// ************************************************************
+double
+runStrategy (ReplacementStrategy strategy, PageNumber *pages, bool *dirty, int numOps, BM_PoolStats *stats)
+{
+  BM_BufferPool *bm = MAKE_POOL();
+  BM_PageHandle h;
+  double start, end;
+  int i;
+
+  CHECK(initBufferPool(bm, BENCH_PAGE_FILE, BENCH_POOL_PAGES, strategy, NULL));
+  start = nowSeconds();
+  for (i = 0; i < numOps; i++)
+    {
+      if (pinPage(bm, &h, pages[i]) != RC_OK || h.frameRef == NULL)
+        break;  // a strategy without an implementation fails the pin or leaves the handle empty
+      if (dirty[i])
+        markDirty(bm, &h);
+      unpinPage(bm, &h);
+    }
+  end = nowSeconds();
+  getPoolStats(bm, stats);
+  CHECK(shutdownBufferPool(bm));
+  free(bm);
+
+  return (i < numOps) ? -1 : end - start;
+}
+
+// ************************************************************
+void
+generateWorkload (BenchWorkload workload, PageNumber *pages, bool *dirty, int numOps)
+{
+  double cdf[BENCH_FILE_PAGES];
+  double sum = 0;
+  unsigned int seed = 42;  // every strategy replays the same sequence
+  int scanPos = 0;
+  int i;
+
+  // page p is the (p+1)-th most popular: P(p) is proportional to 1 / (p+1)^theta
+  for (i = 0; i < BENCH_FILE_PAGES; i++)
+    {
+      sum += 1.0 / pow(i + 1, BENCH_ZIPF_THETA);
+      cdf[i] = sum;
+    }
+
+  for (i = 0; i < numOps; i++)
+    {
+      bool zipf = workload == WL_ZIPF || (workload == WL_MIXED && i % 5 != 0);
+
+      dirty[i] = FALSE;
+      if (workload == WL_UNIFORM)
+        pages[i] = rand_r(&seed) % BENCH_FILE_PAGES;
+      else if (zipf)
+        {
+          double u = sum * rand_r(&seed) / ((double) RAND_MAX + 1);
+          int lo = 0, hi = BENCH_FILE_PAGES - 1;
+
+          while (lo < hi)  // first page whose cumulative weight exceeds u
+            {
+              int mid = (lo + hi) / 2;
+              if (cdf[mid] > u)
+                hi = mid;
+              else
+                lo = mid + 1;
+            }
+          pages[i] = lo;
+          dirty[i] = workload == WL_MIXED && rand_r(&seed) % 5 == 0;
+        }
+      else
+        {
+          pages[i] = scanPos;  // sequential, and the scan part of mixed
+          scanPos = (scanPos + 1) % BENCH_FILE_PAGES;
+        }
+    }
+}
+
+// ************************************************************
+long
+latencyPercentile (const long *histogram, double fraction)
+{
+  long total = 0, seen = 0;
+  int i;
+
+  for (i = 0; i < BM_LATENCY_BUCKETS; i++)
+    total += histogram[i];
+  for (i = 0; i < BM_LATENCY_BUCKETS - 1; i++)
+    {
+      seen += histogram[i];
+      if (seen >= fraction * total)
+        break;
+    }
+  return 1L << i;  // bucket i holds latencies below 2^i us
+}
+
+// ************************************************************
+int
+openTlbCounter (void)
+{
+#ifdef __linux__
+  struct perf_event_attr attr;
+
+  memset(&attr, 0, sizeof(attr));
+  attr.size = sizeof(attr);
+  attr.type = PERF_TYPE_HW_CACHE;
+  attr.config = PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8)
+      | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  return (int) syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+#else
+  return -1;  // no perf counters; the table shows n/a
+#endif
+}
+
+// ************************************************************
+void *
+runWorker (void *arg)
+{
+  BenchWorker *w = (BenchWorker *) arg;
+  BM_PageHandle h;
+  int i;
+
+  for (i = 0; i < w->numOps; i++)
+    {
+      int pageNum = (rand_r(&w->seed) % 10 < 9)
+          ? rand_r(&w->seed) % BENCH_HOT_PAGES
+          : rand_r(&w->seed) % BENCH_FILE_PAGES;
+
+      if (pinPage(w->bm, &h, pageNum) != RC_OK)
+        {
+          w->failedPins++;
+          continue;
+        }
+      unpinPage(w->bm, &h);
+    }
+
+  return NULL;
+}
+
+// ************************************************************
+void *
+runDescents (void *arg)
+{
+  BenchWorker *w = (BenchWorker *) arg;
+  BM_PageHandle h;
+  int i, level;
+
+  for (i = 0; i < w->numOps; i++)
+    for (level = 0; level < 3; level++)
+      {
+        int pageNum = (level == 0) ? 0
+            : (level == 1) ? 1 + rand_r(&w->seed) % BENCH_INNER_PAGES
+            : 1 + BENCH_INNER_PAGES + rand_r(&w->seed) % (BENCH_FILE_PAGES - 1 - BENCH_INNER_PAGES);
+
+        if (pinPage(w->bm, &h, pageNum) != RC_OK)
+          {
+            w->failedPins++;
+            continue;
+          }
+        unpinPageRef(w->bm, &h);
+      }
+
+  return NULL;
+}
+
+// ************************************************************
+void
+createBenchFile (char *fileName, int numPages)
+{
+  SM_FileHandle fh;
+
+  CHECK(createPageFile(fileName));
+  CHECK(openPageFile(fileName, &fh));
+  CHECK(ensureCapacity(numPages, &fh));
+  CHECK(closePageFile(&fh));
+}
+
+// ************************************************************
+double
+nowSeconds (void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+}
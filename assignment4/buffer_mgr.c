@@ -1,532 +1,4799 @@
-#include "buffer_mgr.h"
-#include "storage_mgr.h"
-#include <string.h>
-#include <stdlib.h>
-
-typedef struct Frame {
-    int currpage; //the corresponding page in the file
-    bool dirty;
-    int fixCount;
-    bool refbit; //true=1 false=0 for clock
-    struct Frame *next;
-    struct Frame *prev;
-    char data[PAGE_SIZE];
-   
-} Frame;
-
-typedef struct statlist{
-    struct statlist *next;
-    Frame *fpt; //Frame pt
-}statlist;
-
-typedef struct Buffer{ //use as a class
-    int numRead; //for readIO
-    void *stratData; //sizeof(void)=8 siszeof(int)=4;
-    int numFrames; // number of frames in the frame list
-    int numWrite; //for writeIO
-    //int pinnNum; //pinned frames
-    Frame *head;
-    statlist *stathead; //statistics functions have to follow true sequence -.-|
-    Frame *pointer; //special purposes;init as bfhead;clock used
-    Frame *tail;
-}Buffer;
-
-
-/********************************************** Custom Functions***********************************************/
-Frame *alreadyPinned(BM_BufferPool *const bm, const PageNumber pageNum)
-/* Verifies if the given pageNum is already pinned.
-   If found, increments the pin count and returns the Frame pointer.
-   Returns NULL if not found. */
-{
-    Buffer *bufferMgr = bm->mgmtData;   // Renamed for better clarity
-    Frame *currentFrame = bufferMgr->head; // Start from the head of the buffer
-
-    do {
-        if (currentFrame->currpage == pageNum) {
-            currentFrame->fixCount++;  // Increment pin count if page is pinned
-            return currentFrame;
-        }
-        currentFrame = currentFrame->next; // Move to the next frame
-    } while (currentFrame != bufferMgr->head); // Loop back to head if not found
-
-    return NULL;  // Return NULL if the page is not pinned
-}
-
-int pinThispage(BM_BufferPool *const bm, Frame *frame, PageNumber pageNum)
-/* Pins the specified pageNum to the given frame. 
-   Handles reading and writing data as necessary. */
-{
-    Buffer *bufferMgr = bm->mgmtData;
-    SM_FileHandle fileHandle;
-    RC resultCode;
-
-    // Open the page file
-    resultCode = openPageFile(bm->pageFile, &fileHandle);
-    if (resultCode != RC_OK) return resultCode;
-
-    // Ensure the pageNum is within file capacity
-    resultCode = ensureCapacity(pageNum, &fileHandle);
-    if (resultCode != RC_OK) return resultCode;
-
-    // If the frame is dirty, write its content to disk
-    if (frame->dirty) {
-        resultCode = writeBlock(frame->currpage, &fileHandle, frame->data);
-        if (resultCode != RC_OK) return resultCode;
-
-        frame->dirty = false;        // Reset the dirty flag
-        bufferMgr->numWrite++;       // Increment write count
-    }
-
-    // Read the new page into the frame
-    resultCode = readBlock(pageNum, &fileHandle, frame->data);
-    if (resultCode != RC_OK) return resultCode;
-
-    bufferMgr->numRead++;            // Increment read count
-    frame->currpage = pageNum;       // Update frame with the new page number
-    frame->fixCount++;               // Increment the fix count
-
-    closePageFile(&fileHandle);      // Close the page file
-    return RC_OK;
-}
-
-
-/* Pinning Functions*/
-RC pinFIFO(BM_BufferPool *const bm, BM_PageHandle *const page, const PageNumber pageNum, bool isFromLRU)
-/* Pins the first available frame using the FIFO strategy and moves the frame to the tail of the queue.
-   If called by LRU, no need to check if the page is already pinned. */
-{
-    if (!isFromLRU && alreadyPinned(bm, pageNum)) {
-        return RC_OK;  // Page is already pinned
-    }
-
-    Buffer *bufferMgr = bm->mgmtData;
-    Frame *currentFrame = bufferMgr->head;
-    bool frameFound = false;
-
-    // Find the first available frame with fix count 0
-    do {
-        if (currentFrame->fixCount == 0) {
-            frameFound = true;
-            break;
-        }
-        currentFrame = currentFrame->next;
-    } while (currentFrame != bufferMgr->head);
-
-    if (!frameFound) {
-        return RC_IM_NO_MORE_ENTRIES;  // No available frame
-    }
-
-    // Pin the page to the frame
-    RC resultCode = pinThispage(bm, currentFrame, pageNum);
-    if (resultCode != RC_OK) return resultCode;
-
-    page->pageNum = pageNum;
-    page->data = currentFrame->data;
-
-    // Adjust the frame list to move the used frame to the tail
-    if (currentFrame == bufferMgr->head) {
-        bufferMgr->head = currentFrame->next;
-    }
-    currentFrame->prev->next = currentFrame->next;
-    currentFrame->next->prev = currentFrame->prev;
-
-    currentFrame->prev = bufferMgr->tail;
-    bufferMgr->tail->next = currentFrame;
-    bufferMgr->tail = currentFrame;
-
-    currentFrame->next = bufferMgr->head;
-    bufferMgr->head->prev = currentFrame;
-
-    return RC_OK;
-}
-
-RC pinLRU(BM_BufferPool *const bm, BM_PageHandle *const page, const PageNumber pageNum)
-/* Pins the page using the LRU strategy. 
-   If the page is already pinned, it moves the frame to the tail of the list. 
-   Otherwise, it behaves like FIFO. */
-{
-    Frame *pinnedFrame = alreadyPinned(bm, pageNum);
-    if (pinnedFrame) {
-        // Adjust frame priority by moving the pinned frame to the tail
-        Buffer *bufferMgr = bm->mgmtData;
-        if (pinnedFrame == bufferMgr->head) {
-            bufferMgr->head = pinnedFrame->next;
-        }
-        pinnedFrame->prev->next = pinnedFrame->next;
-        pinnedFrame->next->prev = pinnedFrame->prev;
-
-        pinnedFrame->prev = bufferMgr->tail;
-        bufferMgr->tail->next = pinnedFrame;
-        bufferMgr->tail = pinnedFrame;
-
-        pinnedFrame->next = bufferMgr->head;
-        bufferMgr->head->prev = pinnedFrame;
-
-        page->pageNum = pageNum;
-        page->data = pinnedFrame->data;
-    } else {
-        // If not pinned, fallback to FIFO pinning
-        return pinFIFO(bm, page, pageNum, true);
-    }
-    return RC_OK;
-}
-
-RC pinCLOCK(BM_BufferPool *const bm, BM_PageHandle *const page, const PageNumber pageNum)
-/* Implements the CLOCK page replacement strategy.
-   Uses a pointer to scan frames without reordering the queue. */
-{
-    if (alreadyPinned(bm, pageNum)) {
-        return RC_OK;  // Page is already pinned
-    }
-
-    Buffer *bufferMgr = bm->mgmtData;
-    Frame *currentFrame = bufferMgr->pointer->next;
-    bool frameFound = false;
-
-    // Scan frames using CLOCK algorithm
-    while (currentFrame != bufferMgr->pointer) {
-        if (currentFrame->fixCount == 0) {
-            if (!currentFrame->refbit) {  // If refbit is 0
-                frameFound = true;
-                break;
-            }
-            currentFrame->refbit = false;  // Reset refbit during the scan
-        }
-        currentFrame = currentFrame->next;
-    }
-
-    if (!frameFound) {
-        return RC_IM_NO_MORE_ENTRIES;  // No available frame
-    }
-
-    // Pin the page to the selected frame
-    RC resultCode = pinThispage(bm, currentFrame, pageNum);
-    if (resultCode != RC_OK) {
-        return resultCode;
-    }
-
-    // Update the CLOCK pointer
-    bufferMgr->pointer = currentFrame;
-
-    // Update page details
-    page->pageNum = pageNum;
-    page->data = currentFrame->data;
-
-    return RC_OK;
-}
-
-RC pinLRUK (BM_BufferPool *const bm, BM_PageHandle *const page,
-            const PageNumber pageNum)
-{
-    
-    return RC_OK;
-}
-
-/************************************Assignment Functions**************************************/
-
-RC initBufferPool(BM_BufferPool *const bm, const char *const pageFileName,
-                  const int numPages, ReplacementStrategy strategy,
-                  void *stratData)
-//initialization: create page frames using circular list; init bm;
-{
-    //error check
-    if (numPages<=0) //input check
-        return RC_WRITE_FAILED;
-    //init bf:bookkeeping data
-    Buffer *bf = malloc(sizeof(Buffer));
-    
-    if (bf==NULL) return RC_WRITE_FAILED;
-    bf->numFrames = numPages;
-    bf->stratData = stratData;
-    bf->numRead = 0;
-    bf->numWrite = 0;
-    //create list
-    int i;
-    Frame *phead = malloc(sizeof(Frame));
-    statlist *shead = malloc(sizeof(statlist));
-    if (phead==NULL) return RC_WRITE_FAILED;
-    phead->currpage=NO_PAGE;
-    phead->refbit=false;
-    phead->dirty=false;
-    phead->fixCount=0;
-    memset(phead->data,'\0',PAGE_SIZE);
-    shead->fpt = phead;
-    
-    bf->head = phead;
-    bf->stathead = shead;
-    
-    for (i=1; i<numPages; i++) { //i start from 1
-        Frame *pnew = malloc(sizeof(Frame));
-        statlist *snew = malloc(sizeof(statlist));
-        if (pnew==NULL) return RC_WRITE_FAILED;
-        pnew->currpage=NO_PAGE;
-        pnew->dirty=false;
-        pnew->refbit=false;
-        pnew->fixCount=0;
-        memset(pnew->data,'\0',PAGE_SIZE);
-        
-        snew->fpt = pnew;
-        shead->next = snew;
-        shead = snew;
-        
-        phead->next=pnew;
-        pnew->prev=phead;
-        phead=pnew;
-    }
-    shead->next = NULL;
-    bf->tail = phead;
-    bf->pointer = bf->head;
-    
-    //circular list for clock
-    bf->tail->next = bf->head;
-    bf->head->prev = bf->tail;
-    
-    //init bm
-    bm->numPages = numPages;
-    bm->pageFile = (char *)pageFileName;
-    bm->strategy = strategy;
-    bm->mgmtData = bf;
-    
-    return RC_OK;
-}
-
-RC shutdownBufferPool(BM_BufferPool *const bm)
-/* Shuts down the buffer pool, writing dirty pages back to disk and releasing allocated resources. */
-{
-    // Flush all dirty pages to disk
-    RC resultCode = forceFlushPool(bm);
-    if (resultCode != RC_OK) {
-        return resultCode;
-    }
-
-    // Free allocated resources
-    Buffer *bufferMgr = bm->mgmtData;
-    Frame *currentFrame = bufferMgr->head;
-
-    // Deallocate all frames in the circular list
-    while (currentFrame != bufferMgr->tail) {
-        Frame *nextFrame = currentFrame->next;
-        free(currentFrame);
-        currentFrame = nextFrame;
-    }
-    free(bufferMgr->tail);  // Free the last frame
-    free(bufferMgr);        // Free the buffer manager
-
-    // Reset the buffer pool's metadata
-    bm->numPages = 0;
-    bm->pageFile = NULL;
-    bm->mgmtData = NULL;
-
-    return RC_OK;
-}
-
-RC forceFlushPool(BM_BufferPool *const bm)
-/* Writes all dirty pages with a fix count of 0 back to disk, ensuring data consistency. */
-{
-    Buffer *bufferMgr = bm->mgmtData;
-    SM_FileHandle fileHandle;
-
-    // Open the page file
-    RC resultCode = openPageFile(bm->pageFile, &fileHandle);
-    if (resultCode != RC_OK) {
-        return resultCode;
-    }
-
-    Frame *currentFrame = bufferMgr->head;
-
-    // Iterate over all frames and write dirty pages to disk
-    do {
-        if (currentFrame->dirty) {
-            resultCode = writeBlock(currentFrame->currpage, &fileHandle, currentFrame->data);
-            if (resultCode != RC_OK) {
-                closePageFile(&fileHandle);
-                return resultCode;
-            }
-            currentFrame->dirty = false;  // Mark page as clean
-            bufferMgr->numWrite++;       // Increment write count
-        }
-        currentFrame = currentFrame->next;
-    } while (currentFrame != bufferMgr->head);
-
-    // Close the page file
-    closePageFile(&fileHandle);
-    return RC_OK;
-}
-
-// Buffer Manager Interface Access Pages
-RC markDirty(BM_BufferPool *const bm, BM_PageHandle *const page)
-/* Marks the frame corresponding to the given page as dirty, indicating that it has been modified. */
-{
-    Buffer *bufferMgr = bm->mgmtData;
-    Frame *currentFrame = bufferMgr->head;
-
-    // Traverse the frame list to find the frame associated with the page
-    do {
-        if (currentFrame->currpage == page->pageNum) {
-            currentFrame->dirty = true;  // Mark the frame as dirty
-            return RC_OK;
-        }
-        currentFrame = currentFrame->next;
-    } while (currentFrame != bufferMgr->head);
-
-    // Page not found
-    return RC_READ_NON_EXISTING_PAGE;
-}
-
-RC unpinPage(BM_BufferPool *const bm, BM_PageHandle *const page)
-/* Unpins the page from the buffer pool, reducing its fix count. 
-   Resets the reference bit if the fix count becomes zero. */
-{
-    Buffer *bufferMgr = bm->mgmtData;
-    Frame *currentFrame = bufferMgr->head;
-
-    // Traverse the frame list to find the frame associated with the page
-    do {
-        if (currentFrame->currpage == page->pageNum) {
-            if (currentFrame->fixCount > 0) {
-                currentFrame->fixCount--;  // Decrement the fix count
-                if (currentFrame->fixCount == 0) {
-                    currentFrame->refbit = false;  // Reset the reference bit
-                }
-                return RC_OK;
-            } else {
-                return RC_READ_NON_EXISTING_PAGE;  // Page is already unpinned
-            }
-        }
-        currentFrame = currentFrame->next;
-    } while (currentFrame != bufferMgr->head);
-
-    // Page not found in the buffer pool
-    return RC_READ_NON_EXISTING_PAGE;
-}
-
-RC forcePage(BM_BufferPool *const bm, BM_PageHandle *const page)
-/* Writes the given page from the buffer pool to disk, ensuring the page is saved. */
-{
-    Buffer *bufferMgr = bm->mgmtData;
-    SM_FileHandle fileHandle;
-
-    // Open the page file
-    RC resultCode = openPageFile(bm->pageFile, &fileHandle);
-    if (resultCode != RC_OK) {
-        return RC_FILE_NOT_FOUND;
-    }
-
-    // Write the page data to disk
-    resultCode = writeBlock(page->pageNum, &fileHandle, page->data);
-    if (resultCode != RC_OK) {
-        closePageFile(&fileHandle);  // Ensure the file is closed on error
-        return RC_WRITE_FAILED;
-    }
-
-    // Increment the write count in the buffer manager
-    bufferMgr->numWrite++;
-
-    // Close the page file
-    closePageFile(&fileHandle);
-    return RC_OK;
-}
-
-RC pinPage(BM_BufferPool *const bm, BM_PageHandle *const page, const PageNumber pageNum)
-/* Pins the specified page in the buffer pool using the appropriate replacement strategy. */
-{
-    // Validate the page number
-    if (pageNum < 0) {
-        return RC_IM_KEY_NOT_FOUND;
-    }
-
-    // Determine the replacement strategy and pin the page accordingly
-    switch (bm->strategy) {
-        case RS_FIFO:
-            return pinFIFO(bm, page, pageNum, false);
-        case RS_LRU:
-            return pinLRU(bm, page, pageNum);
-        case RS_CLOCK:
-            return pinCLOCK(bm, page, pageNum);
-        case RS_LRU_K:
-            return pinLRUK(bm, page, pageNum);
-        default:
-            return RC_IM_KEY_NOT_FOUND;  // Unknown replacement strategy
-    }
-}
-
-PageNumber *getFrameContents (BM_BufferPool *const bm)
-{
-    // Allocate memory to store the current page numbers for all frames
-    PageNumber *frameContents = calloc(bm->numPages, sizeof(int));
-
-    // Access buffer metadata and the head of the statistics list
-    Buffer *bufferInfo = bm->mgmtData;
-    statlist *currentStatNode = bufferInfo->stathead;
-
-    // Iterate through the list to populate the frame contents
-    for (int pageIndex = 0; pageIndex < bm->numPages; pageIndex++)
-    {
-        frameContents[pageIndex] = currentStatNode->fpt->currpage;
-        currentStatNode = currentStatNode->next;
-    }
-
-    // Return the array with the frame contents
-    return frameContents;
-}
-
-bool *getDirtyFlags (BM_BufferPool *const bm)
-{
-    // Allocate memory for storing dirty flags for all pages
-    bool *dirtyFlagArray = calloc(bm->numPages, sizeof(bool));
-
-    // Retrieve buffer metadata and the statistics list
-    Buffer *bufferInfo = bm->mgmtData;
-    statlist *currentStatNode = bufferInfo->stathead;
-
-    // Iterate over the pages to populate the dirty flags
-    for (int pageIndex = 0; pageIndex < bm->numPages; pageIndex++)
-    {
-        if (currentStatNode->fpt->dirty)
-        {
-            dirtyFlagArray[pageIndex] = true;
-        }
-        currentStatNode = currentStatNode->next;
-    }
-
-    // Return the array containing the dirty flags
-    return dirtyFlagArray;
-}
-
-int *getFixCounts (BM_BufferPool *const bm)
-{
-    // Allocate memory to store fix counts for all pages
-    PageNumber *fixCountArray = calloc(bm->numPages, sizeof(int));
-
-    // Retrieve the buffer and statistics list
-    Buffer *bufferMetadata = bm->mgmtData;
-    statlist *currentStat = bufferMetadata->stathead;
-
-    // Iterate through pages to extract fix counts
-    for (int pageIndex = 0; pageIndex < bm->numPages; pageIndex++)
-    {
-        fixCountArray[pageIndex] = currentStat->fpt->fixCount;
-        currentStat = currentStat->next;
-    }
-
-    // Return the populated fix count array
-    return fixCountArray;
-}
-
-int fetchReadIOCount (BM_BufferPool *const bufferPool)
-{
-    // Access the buffer metadata
-    Buffer *bufferManager = bufferPool->mgmtData;
-
-    // Retrieve and return the read I/O count
-    return bufferManager->numRead;
-}
-
-int fetchWriteIOCount (BM_BufferPool *const bufferPool)
-{
-    // Extract the buffer manager metadata
-    Buffer *bufferManagerData = bufferPool->mgmtData;
-
-    // Return the number of write operations
-    return bufferManagerData->numWrite;
-}
+#include "buffer_mgr.h"
+#include "storage_mgr.h"
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <time.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#define NUM_LATCH_PARTITIONS 16 //page table partitions, each guarded by its own latch
+#define MAX_POOL_FILES 64 //page files attached to one pool at the same time
+#define PRELOAD_BATCH_PAGES 64 //pages per pinPages call when preloading a hot-page list
+#define TRACE_BUFFER_RECORDS 1024 //pin trace records collected before a write
+#define OPTIMISTIC_RETRIES 3 //optimistic read attempts before readPageOptimistic falls back to a pin
+#define HUGE_PAGE_BYTES (2 * 1024 * 1024) //alignment and size unit of huge page arena chunks
+#define NUM_SHADOWS 4 //strategies the adaptive mode replays: FIFO, LRU, CLOCK and GCLOCK
+#define ADAPT_SHADOW_FRAMES 64 //shadow cache size the page sampling rate aims for
+#define ADAPT_MIN_GAIN 0.02 //share of a window's sampled pins another strategy must hit more to be switched to
+#define COMPRESS_HASH_BITS 11 //the page codec finds matches through 2^bits recent 4-byte sequences
+#define COMPRESS_MIN_MATCH 4 //shortest repeat the page codec encodes as a match
+#define PIN_CACHE_SLOTS 8 //entries of each thread's pin cache, indexed by page hash
+#define SCRATCH_FILE MAX_POOL_FILES //Frame.fileId of scratch pages; past the registry, so no page file ever has it
+
+typedef _Atomic(struct Frame *) FrameLink; //page table slot or hashNext; optimistic readers follow them unlatched
+
+typedef struct Frame {
+    int currpage; //the corresponding page in the file
+    int fileId; //file of currpage, index into Buffer.files
+    bool dirty;
+    atomic_int fixCount; //incremented under the page's partition latch, decremented without it
+    atomic_int usage; //CLOCK and GCLOCK: hits since the hand last passed, up to Buffer.maxUsage; LRU: 1 while a hit waits to be moved to the tail
+    bool ioInProgress; //a read into this frame is in flight; pinners wait on the partition's ioDone
+    bool prefetched; //loaded by prefetchPages and not pinned since
+    int dirtyIdx; //slot in Buffer.dirtySet while dirty, -1 when clean
+    int loadSeq; //value of loadClock when the current page was read in
+    atomic_uint version; //even while the frame holds a stable page, odd while it changes; see readPageOptimistic
+    atomic_uint residency; //bumped before the frame may lose its page, so thread pin caches notice; see pinFromCache
+    struct Frame *next;
+    struct Frame *prev;
+    FrameLink hashNext; //next frame in the same page table bucket
+    char *data; //PAGE_SIZE slot in the pool's arena
+    pthread_rwlock_t pageLatch; //shared/exclusive latch of pinned handles (BM_LatchMode); only taken with a pin held
+
+} Frame;
+
+typedef struct statlist{
+    struct statlist *next;
+    Frame *fpt; //Frame pt
+}statlist;
+
+typedef struct Retired{ //memory optimistic readers may still be looking at; freed with the pool
+    void *block;
+    struct Retired *next;
+}Retired;
+
+typedef struct ArenaChunk{ //one mapping of frame data slots
+    char *base;
+    size_t bytes;
+    struct ArenaChunk *next;
+}ArenaChunk;
+
+typedef struct QueuedWrite{ //a dirty victim's page waiting in the write-behind queue
+    int fileId;
+    PageNumber pageNum;
+    char *data; //PAGE_SIZE buffer that belongs to the slot; moves with the entry
+}QueuedWrite;
+
+typedef enum ScratchState{ //what the pool knows of a scratch page number
+    SCRATCH_FREE = 0, //not allocated
+    SCRATCH_NEW, //allocated and never spilled: reads as zeros
+    SCRATCH_SPILLED //allocated; the temp file has its last spilled copy
+}ScratchState;
+
+typedef struct PinCacheEntry{ //a page the thread pinned recently
+    unsigned long poolSerial; //Buffer.poolSerial of its pool; 0 for an empty entry
+    int fileId;
+    PageNumber pageNum;
+    struct Frame *frame;
+    unsigned int residency; //frame->residency while the thread held its pin
+    bool referenced; //re-pinned through the entry since a pin of another page spared it
+}PinCacheEntry;
+
+typedef struct PoolFile{
+    char *name; //own copy of the page file name; NULL for a free slot
+    int refCount; //views attached to this file
+    int numScans; //synchronized scans of the file in progress, under the pool latch
+    atomic_int scanPosition; //page the most recent of them reached
+}PoolFile;
+
+typedef struct PageKey{
+    int fileId;
+    PageNumber pageNum;
+}PageKey;
+
+typedef struct WriteBack{ //a victim's dirty page being written after its frame was given a new page
+    PageKey key; //pageNum is NO_PAGE when the victim needs no write
+    struct WriteBack *next;
+}WriteBack;
+
+typedef struct CompressedPage{ //a clean victim's page kept in the compressed cache
+    PageKey key;
+    unsigned long stamp; //tells the eviction that reserved the entry apart from later ones of the page
+    int size; //bytes at data: PAGE_SIZE for a page stored raw, -1 while only reserved
+    unsigned char *data;
+    struct CompressedPage *hashNext; //next entry in the same bucket
+    struct CompressedPage *newer; //age list, dropped from the oldest end when over budget
+    struct CompressedPage *older;
+}CompressedPage;
+
+typedef struct CacheReservation{ //entry evictAndPublish reserved for its victim's page
+    PageKey key;
+    unsigned long stamp; //0 if nothing was reserved
+}CacheReservation;
+
+typedef struct ShadowCache{ //one strategy replayed on the sampled pins; page keys only, no data
+    ReplacementStrategy strategy;
+    PageKey *keys; //fileId -1 for an empty slot
+    unsigned int *meta; //LRU: stamp of the last use; CLOCK and GCLOCK: usage counter
+    int hand; //FIFO: next slot to refill; CLOCK and GCLOCK: the clock hand
+    long hits; //sampled pins it hit in the current window
+}ShadowCache;
+
+struct BM_SyncScan{ //one scan's walk over [firstPage, endPage), starting wherever the others are
+    struct Buffer *buffer;
+    int fileId;
+    PageNumber firstPage;
+    PageNumber endPage;
+    PageNumber nextPage; //returned by the next nextSyncScanPage
+    int remaining; //pages not returned yet
+};
+
+struct BM_AccessRing{ //pages one caller loaded through pinPageWithRing, oldest at next
+    int size;
+    int next; //slot whose page is recycled on the caller's next miss
+    PageKey *slots; //fileId -1 for an unused slot
+};
+
+typedef struct PoolStatCounters{ //pin and eviction statistics behind getPoolStats
+    atomic_long numHits; //pins served from a resident frame
+    atomic_long numMisses; //pins that read the page in
+    atomic_long numPinWaits; //pins that waited for another thread's read of the page
+    atomic_long numPinCacheHits; //pins served from the thread's pin cache
+    atomic_long numSearches; //victim searches of the strategy
+    atomic_long numSearchSteps; //frames examined by them
+    atomic_long searchLength[BM_SEARCH_BUCKETS]; //histogram of frames examined per search
+    atomic_long hitLatency[BM_LATENCY_BUCKETS]; //histograms of pinPage latency, see BM_LATENCY_BUCKETS
+    atomic_long missLatency[BM_LATENCY_BUCKETS];
+    atomic_int numEvictions; //misses that replaced a resident page
+    atomic_int numCleanEvictions; //...of which the victim needed no write
+    atomic_long numOptimisticReads; //readPageOptimistic calls served without a pin
+    atomic_long numOptimisticFallbacks; //...that had to pin
+    atomic_long numLatchWaits; //page latch requests that waited for another holder
+}PoolStatCounters;
+
+typedef struct FrameArena{ //memory behind Frame.data
+    ArenaChunk *chunks; //unmapped with the pool
+    char *freeSlots; //slots no frame uses, chained through their first bytes
+    int numFreeSlots; //guarded like freeSlots: only touched when creating, resizing or freeing the pool
+    bool hugePages; //hugePages option
+    bool hugeTlb; //hugeTlb option
+    long bytes; //memory mapped for the arena
+    long hugePageBytes; //...of which advised for or mapped with huge pages
+}FrameArena;
+
+typedef struct DirtySet{ //every dirty frame, in no particular order
+    Frame **frames; //room for numFrames
+    int count;
+    pthread_mutex_t latch; //the set and Frame.dirtyIdx; taken last, holds nothing else
+}DirtySet;
+
+typedef struct WriteBacks{ //victims' pages being written back; misses on them wait (see evictAndPublish)
+    WriteBack *list;
+    pthread_mutex_t latch; //list; taken after the pool latch, holds nothing else
+    pthread_cond_t done; //signalled when one of them has been written
+}WriteBacks;
+
+typedef struct BackgroundWriter{ //thread writing dirty pages ahead of eviction and saving hot-page lists
+    bool on; //the thread is running
+    bool rounds; //backgroundWriter option; without it the thread only saves hot-page lists
+    bool stop; //asks the thread to exit
+    int delayMs; //sleep between rounds
+    int maxPages; //pages written per round at most
+    double lowWater; //start a round below this clean fraction of unpinned frames
+    double highWater; //and write until this fraction is clean
+    pthread_t thread;
+    pthread_mutex_t latch; //guards stop and the wakeup
+    pthread_cond_t wakeup; //early wakeup when a miss had to write a dirty victim
+    atomic_int numWrites; //pages written by the thread
+}BackgroundWriter;
+
+typedef struct WriteBehindQueue{ //dirty victims' pages copied out for the background writer to write
+    bool enabled; //writeBehind option: dirty victims are copied to queued instead of written by the miss
+    int capacity; //pages queued plus pages being written, at most
+    QueuedWrite *queued; //waiting for the next batch; room for capacity
+    int numQueued;
+    QueuedWrite *writing; //the batch being written; swapped with queued when a batch starts
+    int numWriting;
+    char *buffers; //the entries' page buffers, 2 * capacity pages
+    pthread_mutex_t latch; //the fields above; taken after the pool latch, holds nothing else
+    pthread_cond_t written; //signalled when a batch has been written
+    atomic_long numQueuedWrites; //dirty victims handed to the queue
+    atomic_long numQueueHits; //misses served from the queue
+}WriteBehindQueue;
+
+typedef struct Prefetcher{ //pages read ahead of their pins, and the optional thread that reads them
+    atomic_int loadClock; //pages read in so far, stamps Frame.loadSeq
+    atomic_int numUnused; //frames with prefetched set
+    atomic_int numPrefetches; //pages read in by prefetchPages
+    atomic_int numHits; //...later pinned
+    atomic_int numWasted; //...evicted without ever being pinned
+    bool on; //asynchronous prefetch thread is running
+    bool stop; //asks the thread to exit
+    PageKey *queue; //ring of pages waiting to be prefetched
+    int capacity; //size of the ring, the frame count at init
+    int head; //index of the oldest queued page
+    int count; //number of queued pages, at most capacity
+    pthread_t thread;
+    pthread_mutex_t latch; //guards the queue and stop
+    pthread_cond_t ready; //signalled when pages are queued or on stop
+}Prefetcher;
+
+typedef struct CompressedCache{ //clean victims kept compressed and checked before a read
+    bool enabled; //compressedCache option
+    long budget; //compressedCacheBytes: entries and their data, at most
+    long bytes; //in use now
+    CompressedPage **table; //(fileId, pageNum) -> entry, chained through hashNext
+    int numBuckets; //a power of two
+    CompressedPage *newest;
+    CompressedPage *oldest;
+    unsigned long stamp; //stamps reservations
+    pthread_mutex_t latch; //the fields above; taken after the pool latch, holds nothing else
+    atomic_long numStores; //clean victims stored
+    atomic_long numHits; //misses served from the cache
+    atomic_long numDrops; //entries dropped to stay within budget
+}CompressedCache;
+
+typedef struct ScratchSpace{ //scratch pages; the fields are under the pool latch
+    FILE *file; //anonymous temp file scratch pages spill to; created by the first spill
+    unsigned char *state; //ScratchState of each scratch page number below end
+    PageNumber *freeList; //freed scratch page numbers, handed out again before new ones
+    int numFree;
+    int capacity; //room in state and freeList
+    PageNumber end; //scratch page numbers handed out so far
+    int numPages; //allocated now
+    atomic_long numSpills; //scratch pages written to the temp file
+}ScratchSpace;
+
+typedef struct GovernorState{ //what the memory governor knows of one pool
+    PageKey ghosts[GOVERNOR_STEP_PAGES]; //ring of the pages evicted last; a miss on one would have hit with that many more frames
+    int ghostNext; //slot of the oldest; ghosts are under the pool latch
+    atomic_long numGhostHits; //misses on a page still in ghosts
+    long gainMark; //numGhostHits at the last rebalance; the fields below are under governorLatch
+    int minFrames; //the governor never shrinks the pool below this
+    struct Buffer *next; //next pool in governedPools
+}GovernorState;
+
+typedef struct AdaptiveState{ //shadow caches the adaptive mode picks the strategy from
+    bool enabled; //adaptiveStrategy option, for a pool started with one of the shadowed strategies
+    int window; //sampled pins per decision
+    int rate; //a page is sampled when its hash is a multiple of this, so shadows stay near ADAPT_SHADOW_FRAMES
+    int shadowFrames; //size of each shadow cache: numFrames / rate when the shadows were built
+    ShadowCache shadows[NUM_SHADOWS];
+    unsigned int shadowClock; //stamps uses in the LRU shadow
+    int windowPins; //sampled pins in the current window
+    pthread_mutex_t latch; //the fields above; taken before the pool latch
+    atomic_long numSwitches; //strategy changes made by the adaptive mode
+}AdaptiveState;
+
+typedef struct HotPages{ //warm restart options
+    bool save; //write <file>.hot on the file's last shutdown
+    int intervalMs; //and from the background thread this often; 0 for never
+    bool preload; //read <file>.hot into the pool when the file is attached
+}HotPages;
+
+typedef struct PinTrace{
+    atomic_int active; //a pin trace is open; checked before taking latch
+    pthread_mutex_t latch; //guards the fields below
+    FILE *file; //NULL when not tracing
+    BM_TraceRecord *records; //records not yet written
+    int count;
+    struct timespec last; //time of the previous record
+}PinTrace;
+
+typedef struct Buffer{ //use as a class
+    atomic_int numRead; //for readIO
+    void *stratData; //sizeof(void)=8 siszeof(int)=4;
+    int numFrames; // number of frames in the frame list
+    atomic_int numWrite; //for writeIO
+    //int pinnNum; //pinned frames
+    Frame *head;
+    statlist *stathead; //statistics functions have to follow true sequence -.-|
+    Frame *pointer; //special purposes;init as bfhead;clock used
+    Frame *tail;
+    _Atomic ReplacementStrategy strategy; //one strategy for every file in the pool; the adaptive mode changes it under the pool latch
+    atomic_int maxUsage; //Frame.usage ceiling of the strategy, see maxUsageOf
+    PoolFile files[MAX_POOL_FILES]; //attached page files; a frame's fileId indexes this
+    int numViews; //BM_BufferPool handles attached to this pool
+    bool keepAlive; //survives its last view (initSharedBufferPool); otherwise freed with it
+    bool threadSafe; //take the latches below; off for single-threaded callers
+    unsigned long poolSerial; //never reused, so a pin cache entry cannot match a new pool at a freed one's address
+    bool pinCache; //pinCache option: threads re-pin their recent pages without a page table lookup
+    atomic_int numBuckets; //page table size, always a power of two; set after pageTable when it grows
+    _Atomic(FrameLink *) pageTable; //(fileId, pageNum) -> resident frame, chained through hashNext
+    Retired *retired; //frames and page tables given up by resizes
+    pthread_mutex_t flushLatch; //background writer round vs. detaching a file
+    pthread_mutex_t resizeLatch; //one resizeBufferPool at a time
+    pthread_mutex_t extendLatch; //one page file extension at a time; taken alone
+    pthread_mutex_t poolLatch; //frame list, clock pointer, file registry and reassigning a frame to a new page
+    pthread_mutex_t partLatch[NUM_LATCH_PARTITIONS]; //page table buckets, fixCount increments, ioInProgress
+    pthread_cond_t ioDone[NUM_LATCH_PARTITIONS]; //signalled when a read into a frame of the partition finishes
+    PoolStatCounters stats;
+    FrameArena arena;
+    DirtySet dirtySet;
+    WriteBacks writeBacks;
+    BackgroundWriter writer;
+    WriteBehindQueue wb;
+    Prefetcher prefetch;
+    CompressedCache cc;
+    ScratchSpace scratch;
+    GovernorState governor;
+    AdaptiveState adapt;
+    HotPages hot;
+    PinTrace trace;
+}Buffer;
+
+typedef struct PoolView{ //what BM_BufferPool.mgmtData points to
+    Buffer *buffer; //private pool or the shared one
+    int fileId; //this handle's page file in buffer->files
+}PoolView;
+
+static Buffer *sharedPool = NULL; //pool behind attachBufferPool
+static atomic_ulong lastPoolSerial = 0; //Buffer.poolSerial of the newest pool
+static Buffer *governedPools = NULL; //every pool in the process, for the memory governor
+static long memoryBudget = 0; //frame memory all pools together may use; 0 for no limit
+static pthread_mutex_t governorLatch = PTHREAD_MUTEX_INITIALIZER; //the two above; taken after sharedLatch, before any pool latch
+static _Thread_local PinCacheEntry pinCache[PIN_CACHE_SLOTS]; //the calling thread's recent pins, all pools together
+static pthread_mutex_t sharedLatch = PTHREAD_MUTEX_INITIALIZER; //sharedPool and attaching/detaching views
+
+
+/********************************************** Custom Functions***********************************************/
+static void latch(Buffer *bufferMgr, pthread_mutex_t *mutex)
+/* Acquires the given latch when the pool runs in thread-safe mode. */
+{
+    if (bufferMgr->threadSafe) pthread_mutex_lock(mutex);
+}
+
+static void unlatch(Buffer *bufferMgr, pthread_mutex_t *mutex)
+/* Releases a latch taken with latch(). */
+{
+    if (bufferMgr->threadSafe) pthread_mutex_unlock(mutex);
+}
+
+static Buffer *bufferOf(BM_BufferPool *const bm)
+/* The pool behind a handle, or NULL if the handle is not initialised. */
+{
+    PoolView *view = bm->mgmtData;
+    return (view != NULL) ? view->buffer : NULL;
+}
+
+static int fileOf(BM_BufferPool *const bm)
+/* The handle's page file in its pool's file registry. */
+{
+    return ((PoolView *)bm->mgmtData)->fileId;
+}
+
+static unsigned int hashOf(int fileId, PageNumber pageNum)
+/* Multiplicative hash of the (file, page) pair. */
+{
+    unsigned int key = ((unsigned int)pageNum + (unsigned int)fileId * 0x9E3779B9u) * 2654435761u;
+    return key ^ (key >> 16);
+}
+
+static int bucketOf(Buffer *bufferMgr, int fileId, PageNumber pageNum)
+/* Page table bucket of (fileId, pageNum). Caller holds the page's partition latch. */
+{
+    return (int)(hashOf(fileId, pageNum) & (unsigned int)(bufferMgr->numBuckets - 1));
+}
+
+static int partitionOf(Buffer *bufferMgr, int fileId, PageNumber pageNum)
+/* Latch partition owning the bucket of (fileId, pageNum). The bucket count is always a multiple
+   of NUM_LATCH_PARTITIONS, so a page keeps its partition when the page table grows. */
+{
+    return (int)(hashOf(fileId, pageNum) % NUM_LATCH_PARTITIONS);
+}
+
+static Frame *lookupFrame(Buffer *bufferMgr, int fileId, PageNumber pageNum)
+/* Returns the frame holding pageNum of the file, or NULL. Caller holds the page's partition latch. */
+{
+    Frame *frame = bufferMgr->pageTable[bucketOf(bufferMgr, fileId, pageNum)];
+    while (frame != NULL && (frame->currpage != pageNum || frame->fileId != fileId)) {
+        frame = frame->hashNext;
+    }
+    return frame;
+}
+
+static void insertFrame(Buffer *bufferMgr, Frame *frame)
+/* Adds the frame to the page table under its file and currpage. Caller holds the partition latch. */
+{
+    int bucket = bucketOf(bufferMgr, frame->fileId, frame->currpage);
+    frame->hashNext = bufferMgr->pageTable[bucket];
+    bufferMgr->pageTable[bucket] = frame;
+}
+
+static void removeFrame(Buffer *bufferMgr, Frame *frame)
+/* Unlinks the frame from the page table. Caller holds the partition latch. */
+{
+    FrameLink *link = &bufferMgr->pageTable[bucketOf(bufferMgr, frame->fileId, frame->currpage)];
+    while (*link != NULL && *link != frame) {
+        link = &(*link)->hashNext;
+    }
+    if (*link != NULL) {
+        *link = frame->hashNext;
+    }
+    frame->hashNext = NULL;
+}
+
+static void retire(Buffer *bufferMgr, void *block)
+/* Frees block with the pool rather than now, since an optimistic reader may still be reading it.
+   Caller holds the pool latch. */
+{
+    Retired *entry = malloc(sizeof(Retired));
+    if (entry == NULL) return;  // Leak it rather than free memory a reader may be using
+
+    entry->block = block;
+    entry->next = bufferMgr->retired;
+    bufferMgr->retired = entry;
+}
+
+static void moveToTail(Buffer *bufferMgr, Frame *frame)
+/* Moves the frame to the tail of the circular list. Caller holds the pool latch. */
+{
+    if (frame == bufferMgr->tail) return;
+
+    if (frame == bufferMgr->head) {
+        bufferMgr->head = frame->next;
+    }
+    frame->prev->next = frame->next;
+    frame->next->prev = frame->prev;
+
+    frame->prev = bufferMgr->tail;
+    bufferMgr->tail->next = frame;
+    bufferMgr->tail = frame;
+
+    frame->next = bufferMgr->head;
+    bufferMgr->head->prev = frame;
+}
+
+static RC openScratchFile(Buffer *bufferMgr)
+/* Creates the pool's temp file for scratch pages if this is the first spill. Caller holds the pool latch. */
+{
+    if (bufferMgr->scratch.file == NULL) {
+        bufferMgr->scratch.file = tmpfile();  // Unlinked already; the space goes away when it is closed
+        if (bufferMgr->scratch.file == NULL) return RC_WRITE_FAILED;
+    }
+    return RC_OK;
+}
+
+static RC writePage(Buffer *bufferMgr, int fileId, PageNumber pageNum, SM_PageHandle data)
+/* Writes one page to the file it belongs to, which need not be the caller's.
+   A scratch page goes to the temp file, which must exist already. */
+{
+    SM_FileHandle fileHandle;
+    if (fileId == SCRATCH_FILE) {
+        off_t offset = (off_t) pageNum * PAGE_SIZE;
+        return (pwrite(fileno(bufferMgr->scratch.file), data, PAGE_SIZE, offset) == PAGE_SIZE) ? RC_OK : RC_WRITE_FAILED;
+    }
+
+    RC resultCode = openPageFile(bufferMgr->files[fileId].name, &fileHandle);
+    if (resultCode != RC_OK) return resultCode;
+
+    resultCode = writeBlock(pageNum, &fileHandle, data);
+    closePageFile(&fileHandle);
+    return resultCode;
+}
+
+static RC writeScratch(Buffer *bufferMgr, Frame *frame)
+/* Spills a scratch page to the pool's temp file. Caller holds the pool latch. */
+{
+    RC resultCode = openScratchFile(bufferMgr);
+    if (resultCode == RC_OK) {
+        resultCode = writePage(bufferMgr, SCRATCH_FILE, frame->currpage, frame->data);
+    }
+    if (resultCode != RC_OK) return resultCode;
+
+    bufferMgr->scratch.state[frame->currpage] = SCRATCH_SPILLED;
+    atomic_fetch_add(&bufferMgr->scratch.numSpills, 1);
+    return RC_OK;
+}
+
+static RC writeFrame(Buffer *bufferMgr, Frame *frame)
+/* Writes the frame's page back to its own file, which need not be the caller's.
+   A scratch page goes to the temp file; the caller holds the pool latch then. */
+{
+    if (frame->fileId == SCRATCH_FILE) return writeScratch(bufferMgr, frame);
+    return writePage(bufferMgr, frame->fileId, frame->currpage, frame->data);
+}
+
+static void setDirty(Buffer *bufferMgr, Frame *frame)
+/* Marks the frame dirty and adds it to the dirty set. */
+{
+    latch(bufferMgr, &bufferMgr->dirtySet.latch);
+    frame->dirty = true;
+    if (frame->dirtyIdx < 0) {
+        frame->dirtyIdx = bufferMgr->dirtySet.count;
+        bufferMgr->dirtySet.frames[bufferMgr->dirtySet.count++] = frame;
+    }
+    unlatch(bufferMgr, &bufferMgr->dirtySet.latch);
+}
+
+static void clearDirty(Buffer *bufferMgr, Frame *frame)
+/* Marks the frame clean and takes it out of the dirty set, moving the last entry into its slot. */
+{
+    latch(bufferMgr, &bufferMgr->dirtySet.latch);
+    frame->dirty = false;
+    if (frame->dirtyIdx >= 0) {
+        Frame *last = bufferMgr->dirtySet.frames[--bufferMgr->dirtySet.count];
+        bufferMgr->dirtySet.frames[frame->dirtyIdx] = last;
+        last->dirtyIdx = frame->dirtyIdx;
+        frame->dirtyIdx = -1;
+    }
+    unlatch(bufferMgr, &bufferMgr->dirtySet.latch);
+}
+
+Frame *alreadyPinned(Buffer *bufferMgr, int fileId, const PageNumber pageNum, bool *prefetchHit)
+/* Verifies if the given pageNum of the file is already resident.
+   If found, increments the pin count and returns the Frame pointer once any read into it has finished.
+   *prefetchHit (if given) tells whether this is the first pin of a prefetched page.
+   Returns NULL if not found. */
+{
+    if (prefetchHit != NULL) *prefetchHit = false;
+
+    int part = partitionOf(bufferMgr, fileId, pageNum);
+
+    latch(bufferMgr, &bufferMgr->partLatch[part]);
+    Frame *currentFrame = lookupFrame(bufferMgr, fileId, pageNum);
+    if (currentFrame != NULL) {
+        atomic_fetch_add(&currentFrame->fixCount, 1);  // Increment pin count if page is resident
+
+        // Another thread is still reading this page in; share its read instead of issuing our own
+        if (bufferMgr->threadSafe && currentFrame->ioInProgress) {
+            atomic_fetch_add(&bufferMgr->stats.numPinWaits, 1);
+        }
+        while (bufferMgr->threadSafe && currentFrame->ioInProgress) {
+            pthread_cond_wait(&bufferMgr->ioDone[part], &bufferMgr->partLatch[part]);
+        }
+
+        // The read failed and the frame was released; let the caller treat this as a miss
+        if (currentFrame->currpage != pageNum || currentFrame->fileId != fileId) {
+            atomic_fetch_sub(&currentFrame->fixCount, 1);
+            currentFrame = NULL;
+        } else if (currentFrame->prefetched) {
+            currentFrame->prefetched = false;  // The prefetch paid off
+            atomic_fetch_sub(&bufferMgr->prefetch.numUnused, 1);
+            atomic_fetch_add(&bufferMgr->prefetch.numHits, 1);
+            if (prefetchHit != NULL) *prefetchHit = true;
+        }
+    }
+    unlatch(bufferMgr, &bufferMgr->partLatch[part]);
+
+    return currentFrame;
+}
+
+static bool claimFrame(Buffer *bufferMgr, Frame *frame)
+/* Takes an unpinned frame out of the page table so it can be reused.
+   Re-checks the fix count under the partition latch, since hits pin without the pool latch,
+   and pin cache hits without any latch. */
+{
+    if (atomic_load(&frame->fixCount) != 0 || frame->ioInProgress) return false;
+    if (frame->currpage == NO_PAGE) return true;
+
+    int part = partitionOf(bufferMgr, frame->fileId, frame->currpage);
+    bool claimed = false;
+
+    latch(bufferMgr, &bufferMgr->partLatch[part]);
+    atomic_fetch_add(&frame->residency, 1);  // Before the check; pairs with the order in pinFromCache
+    if (atomic_load(&frame->fixCount) == 0 && !frame->ioInProgress) {
+        removeFrame(bufferMgr, frame);
+        claimed = true;
+    }
+    unlatch(bufferMgr, &bufferMgr->partLatch[part]);
+
+    return claimed;
+}
+
+static void releaseClaim(Buffer *bufferMgr, Frame *frame)
+/* Puts a claimed frame back into the page table under its old page, e.g. after a failed write. */
+{
+    if (frame->currpage == NO_PAGE) return;
+
+    int part = partitionOf(bufferMgr, frame->fileId, frame->currpage);
+    latch(bufferMgr, &bufferMgr->partLatch[part]);
+    insertFrame(bufferMgr, frame);
+    unlatch(bufferMgr, &bufferMgr->partLatch[part]);
+}
+
+/* Victim write-back */
+static bool findWriteBack(Buffer *bufferMgr, int fileId, PageNumber pageNum)
+/* Whether writeBacks has an entry for the page, or for any page of the file with NO_PAGE.
+   Caller holds the write-back latch. */
+{
+    for (WriteBack *entry = bufferMgr->writeBacks.list; entry != NULL; entry = entry->next) {
+        if (entry->key.fileId == fileId && (pageNum == NO_PAGE || entry->key.pageNum == pageNum)) return true;
+    }
+    return false;
+}
+
+static bool writeBackPending(Buffer *bufferMgr, int fileId, PageNumber pageNum)
+/* Whether the page is being written back out of a frame that now belongs to another page;
+   NO_PAGE asks about any page of the file. Caller holds the pool latch, under which write-backs
+   start, so the answer holds until it lets go. */
+{
+    latch(bufferMgr, &bufferMgr->writeBacks.latch);
+    bool pending = findWriteBack(bufferMgr, fileId, pageNum);
+    unlatch(bufferMgr, &bufferMgr->writeBacks.latch);
+    return pending;
+}
+
+static void waitForWriteBack(Buffer *bufferMgr, int fileId, PageNumber pageNum)
+/* Waits until writeBackPending is false for the page (NO_PAGE: for the whole file).
+   Called without the pool latch; write-backs only ever pend between two calls of another
+   thread, so there is nothing to wait for single-threaded. */
+{
+    latch(bufferMgr, &bufferMgr->writeBacks.latch);
+    while (bufferMgr->threadSafe && findWriteBack(bufferMgr, fileId, pageNum)) {
+        pthread_cond_wait(&bufferMgr->writeBacks.done, &bufferMgr->writeBacks.latch);
+    }
+    unlatch(bufferMgr, &bufferMgr->writeBacks.latch);
+}
+
+/* Write-behind queue */
+static bool queueWrite(Buffer *bufferMgr, Frame *frame)
+/* Copies a dirty victim's page into the write-behind queue, so the miss that evicts it can read
+   its own page right away. Wakes the background thread once half the queue is in use.
+   Returns false when the queue is full; the caller then writes the page itself. */
+{
+    bool queued = false, wake = false;
+
+    latch(bufferMgr, &bufferMgr->wb.latch);
+    if (bufferMgr->wb.numQueued + bufferMgr->wb.numWriting < bufferMgr->wb.capacity) {
+        QueuedWrite *entry = &bufferMgr->wb.queued[bufferMgr->wb.numQueued++];
+        entry->fileId = frame->fileId;
+        entry->pageNum = frame->currpage;
+        memcpy(entry->data, frame->data, PAGE_SIZE);
+        queued = true;
+        wake = (bufferMgr->wb.numQueued == (bufferMgr->wb.capacity + 1) / 2);
+    }
+    unlatch(bufferMgr, &bufferMgr->wb.latch);
+
+    if (queued) atomic_fetch_add(&bufferMgr->wb.numQueuedWrites, 1);
+    if (wake) {
+        pthread_mutex_lock(&bufferMgr->writer.latch);
+        pthread_cond_signal(&bufferMgr->writer.wakeup);
+        pthread_mutex_unlock(&bufferMgr->writer.latch);
+    }
+    return queued;
+}
+
+static int findQueued(const QueuedWrite *entries, int count, int fileId, PageNumber pageNum)
+/* Index of the entry for the page, or -1. Caller holds the queue latch. */
+{
+    for (int i = 0; i < count; i++) {
+        if (entries[i].pageNum == pageNum && entries[i].fileId == fileId) return i;
+    }
+    return -1;
+}
+
+static bool fileQueued(Buffer *bufferMgr, int fileId)
+/* Whether a page of the file waits in the write-behind queue or is in the batch being written. */
+{
+    bool queued = false;
+
+    latch(bufferMgr, &bufferMgr->wb.latch);
+    for (int i = 0; i < bufferMgr->wb.numQueued && !queued; i++) queued = (bufferMgr->wb.queued[i].fileId == fileId);
+    for (int i = 0; i < bufferMgr->wb.numWriting && !queued; i++) queued = (bufferMgr->wb.writing[i].fileId == fileId);
+    unlatch(bufferMgr, &bufferMgr->wb.latch);
+    return queued;
+}
+
+static bool takeQueuedPage(Buffer *bufferMgr, Frame *frame)
+/* Serves the read into a frame published by evictAndPublish from the write-behind queue if the
+   page still waits there: the frame gets the queued copy and, being dirty, takes over its write.
+   If the page is in the batch being written, waits for that batch so the caller's disk read sees it.
+   Returns whether the page came from the queue. */
+{
+    if (!bufferMgr->wb.enabled) return false;
+
+    bool taken = false;
+    latch(bufferMgr, &bufferMgr->wb.latch);
+    for (;;) {
+        int i = findQueued(bufferMgr->wb.queued, bufferMgr->wb.numQueued, frame->fileId, frame->currpage);
+        if (i >= 0) {
+            QueuedWrite entry = bufferMgr->wb.queued[i];
+            memcpy(frame->data, entry.data, PAGE_SIZE);
+            bufferMgr->wb.queued[i] = bufferMgr->wb.queued[--bufferMgr->wb.numQueued];
+            bufferMgr->wb.queued[bufferMgr->wb.numQueued] = entry;  // Keep its buffer with a free slot
+            taken = true;
+            break;
+        }
+        if (findQueued(bufferMgr->wb.writing, bufferMgr->wb.numWriting, frame->fileId, frame->currpage) < 0) break;
+        pthread_cond_wait(&bufferMgr->wb.written, &bufferMgr->wb.latch);  // writeBehind implies threadSafe
+    }
+    unlatch(bufferMgr, &bufferMgr->wb.latch);
+
+    if (taken) {
+        setDirty(bufferMgr, frame);
+        atomic_fetch_add(&bufferMgr->wb.numQueueHits, 1);
+    }
+    return taken;
+}
+
+static int compareQueuedWrites(const void *a, const void *b)
+/* qsort order for a write-behind batch: by file, then by page. */
+{
+    const QueuedWrite *qa = a;
+    const QueuedWrite *qb = b;
+    if (qa->fileId != qb->fileId) return (qa->fileId > qb->fileId) - (qa->fileId < qb->fileId);
+    return (qa->pageNum > qb->pageNum) - (qa->pageNum < qb->pageNum);
+}
+
+static RC drainWriteBehind(Buffer *bufferMgr)
+/* Writes everything queued so far as one batch: sorted by file and page, with one open handle per
+   file and one writeBlocks call per run of consecutive pages. Pages that fail to write go back
+   into the queue. Waits for a batch another thread is writing first. Holds no latch during the I/O;
+   a queued page's file stays attached until the batch is written, since detaching drains first. */
+{
+    if (!bufferMgr->wb.enabled) return RC_OK;
+
+    latch(bufferMgr, &bufferMgr->wb.latch);
+    while (bufferMgr->wb.numWriting > 0) {
+        pthread_cond_wait(&bufferMgr->wb.written, &bufferMgr->wb.latch);
+    }
+    QueuedWrite *batch = bufferMgr->wb.queued;
+    int batchSize = bufferMgr->wb.numQueued;
+    bufferMgr->wb.queued = bufferMgr->wb.writing;
+    bufferMgr->wb.numQueued = 0;
+    bufferMgr->wb.writing = batch;
+    bufferMgr->wb.numWriting = batchSize;
+    qsort(batch, batchSize, sizeof(QueuedWrite), compareQueuedWrites); // still latched: misses search this batch under wb.latch
+    unlatch(bufferMgr, &bufferMgr->wb.latch);
+
+    if (batchSize == 0) return RC_OK;
+
+    RC resultCode = RC_OK;
+    bool *failed = calloc(batchSize, sizeof(bool));
+    SM_PageHandle *runData = malloc(sizeof(SM_PageHandle) * batchSize);
+    SM_FileHandle fileHandle;
+    int openFile = -1;
+
+    for (int done = 0; done < batchSize; ) {
+        int runLength = 1;
+        while (done + runLength < batchSize && batch[done + runLength].fileId == batch[done].fileId
+               && batch[done + runLength].pageNum == batch[done].pageNum + runLength) {
+            runLength++;
+        }
+
+        RC writeResult = (failed != NULL && runData != NULL) ? RC_OK : RC_MEMORY_ALLOCATION_FAIL;
+        if (writeResult == RC_OK && batch[done].fileId != openFile) {
+            if (openFile >= 0) closePageFile(&fileHandle);
+            openFile = -1;
+            writeResult = openPageFile(bufferMgr->files[batch[done].fileId].name, &fileHandle);
+            if (writeResult == RC_OK) openFile = batch[done].fileId;
+        }
+        if (writeResult == RC_OK) {
+            for (int i = 0; i < runLength; i++) runData[i] = batch[done + i].data;
+            writeResult = writeBlocks(batch[done].pageNum, runLength, &fileHandle, runData);
+        }
+        if (writeResult == RC_OK) {
+            atomic_fetch_add(&bufferMgr->numWrite, runLength);
+        } else {
+            resultCode = writeResult;
+            for (int i = 0; i < runLength && failed != NULL; i++) failed[done + i] = true;
+        }
+        done += runLength;
+    }
+    if (openFile >= 0) closePageFile(&fileHandle);
+
+    latch(bufferMgr, &bufferMgr->wb.latch);
+    for (int i = 0; i < batchSize; i++) {
+        if (failed == NULL || failed[i]) {
+            // Queued and writing pages never exceed the capacity, so there is room to retry later
+            QueuedWrite entry = bufferMgr->wb.queued[bufferMgr->wb.numQueued];
+            bufferMgr->wb.queued[bufferMgr->wb.numQueued++] = batch[i];
+            batch[i] = entry;
+        }
+    }
+    bufferMgr->wb.numWriting = 0;
+    if (bufferMgr->threadSafe) pthread_cond_broadcast(&bufferMgr->wb.written);
+    unlatch(bufferMgr, &bufferMgr->wb.latch);
+
+    free(failed);
+    free(runData);
+    return resultCode;
+}
+
+/* Compressed page cache */
+static int putLength(unsigned char *dst, int pos, int rest)
+/* Writes the part of a length beyond its token field's 15 as steps of 255. Returns the new position. */
+{
+    while (rest >= 255) {
+        dst[pos++] = 255;
+        rest -= 255;
+    }
+    dst[pos++] = (unsigned char)rest;
+    return pos;
+}
+
+static int emitSequence(unsigned char *dst, int pos, const unsigned char *literals, int litLength,
+                        int offset, int matchLength)
+/* Appends a token, its literals and, unless matchLength is 0 (the last token), the match's
+   2-byte back offset. Returns the new position, or -1 if the output would reach PAGE_SIZE. */
+{
+    int matchCode = (matchLength > 0) ? matchLength - COMPRESS_MIN_MATCH : 0;
+    int needed = 1 + litLength / 255 + 1 + litLength + ((matchLength > 0) ? 2 + matchCode / 255 + 1 : 0);
+    if (pos + needed >= PAGE_SIZE) return -1;
+
+    dst[pos++] = (unsigned char)(((litLength < 15) ? litLength : 15) << 4 | ((matchCode < 15) ? matchCode : 15));
+    if (litLength >= 15) pos = putLength(dst, pos, litLength - 15);
+    memcpy(dst + pos, literals, litLength);
+    pos += litLength;
+    if (matchLength > 0) {
+        dst[pos++] = (unsigned char)(offset & 0xFF);
+        dst[pos++] = (unsigned char)(offset >> 8);
+        if (matchCode >= 15) pos = putLength(dst, pos, matchCode - 15);
+    }
+    return pos;
+}
+
+static int compressPage(const unsigned char *src, unsigned char *dst)
+/* LZ77 coding in the style of LZ4: each token byte holds a literal count and a match length in
+   4 bits each (longer ones continue in the following bytes), followed by the literals and the
+   match's back offset. Matches are found through a table of the last position of each hashed
+   4-byte sequence. Returns the compressed size, or -1 if the page does not get smaller. */
+{
+    uint16_t recent[1 << COMPRESS_HASH_BITS];  // Position + 1 of the last sequence with each hash
+    int pos = 0, anchor = 0, i = 0;
+
+    memset(recent, 0, sizeof(recent));
+    while (i + COMPRESS_MIN_MATCH <= PAGE_SIZE) {
+        uint32_t sequence;
+        memcpy(&sequence, src + i, sizeof(sequence));
+        unsigned int hash = (sequence * 2654435761u) >> (32 - COMPRESS_HASH_BITS);
+        int candidate = recent[hash] - 1;
+        recent[hash] = (uint16_t)(i + 1);
+
+        if (candidate >= 0 && memcmp(src + candidate, src + i, COMPRESS_MIN_MATCH) == 0) {
+            int length = COMPRESS_MIN_MATCH;
+            uint64_t ahead, behind;
+            while (i + length + 8 <= PAGE_SIZE) {  // Whole words first, then the bytes of the last one
+                memcpy(&ahead, src + i + length, 8);
+                memcpy(&behind, src + candidate + length, 8);
+                if (ahead != behind) break;
+                length += 8;
+            }
+            while (i + length < PAGE_SIZE && src[candidate + length] == src[i + length]) length++;
+            pos = emitSequence(dst, pos, src + anchor, i - anchor, i - candidate, length);
+            if (pos < 0) return -1;
+            i += length;
+            anchor = i;
+        } else {
+            i += 1 + (i - anchor) / 64;  // Skip faster the longer nothing matched, as LZ4 does
+        }
+    }
+    return emitSequence(dst, pos, src + anchor, PAGE_SIZE - anchor, 0, 0);
+}
+
+static int getLength(const unsigned char *src, int size, int *pos, int length)
+/* Adds the steps following a token field of 15 to length. Returns -1 if they run past size. */
+{
+    unsigned char step;
+    do {
+        if (*pos >= size) return -1;
+        step = src[(*pos)++];
+        length += step;
+    } while (step == 255);
+    return length;
+}
+
+static bool decompressPage(const unsigned char *src, int size, unsigned char *dst)
+/* Decodes a page written by compressPage. Returns false unless it yields exactly PAGE_SIZE bytes. */
+{
+    int in = 0, out = 0;
+
+    while (in < size) {
+        int token = src[in++];
+        int litLength = token >> 4;
+        if (litLength == 15 && (litLength = getLength(src, size, &in, litLength)) < 0) return false;
+        if (litLength > size - in || litLength > PAGE_SIZE - out) return false;
+        memcpy(dst + out, src + in, litLength);
+        in += litLength;
+        out += litLength;
+        if (in == size) break;  // The last token has no match
+
+        if (size - in < 2) return false;
+        int offset = src[in] | (src[in + 1] << 8);
+        in += 2;
+        int matchLength = token & 15;
+        if (matchLength == 15 && (matchLength = getLength(src, size, &in, matchLength)) < 0) return false;
+        matchLength += COMPRESS_MIN_MATCH;
+        if (offset == 0 || offset > out || matchLength > PAGE_SIZE - out) return false;
+        if (offset == 1) {
+            memset(dst + out, dst[out - 1], matchLength);
+            out += matchLength;
+            continue;
+        }
+        while (matchLength > 0) {  // A match may overlap its own output; chunks of offset bytes do not
+            int chunk = (matchLength < offset) ? matchLength : offset;
+            memcpy(dst + out, dst + out - offset, chunk);
+            out += chunk;
+            matchLength -= chunk;
+        }
+    }
+    return out == PAGE_SIZE;
+}
+
+static CompressedPage **compressedLink(Buffer *bufferMgr, int fileId, PageNumber pageNum)
+/* The link pointing at the page's entry, or at the NULL ending its bucket. Caller holds the cache latch. */
+{
+    CompressedPage **link = &bufferMgr->cc.table[hashOf(fileId, pageNum) & (bufferMgr->cc.numBuckets - 1)];
+    while (*link != NULL && ((*link)->key.pageNum != pageNum || (*link)->key.fileId != fileId)) {
+        link = &(*link)->hashNext;
+    }
+    return link;
+}
+
+static CompressedPage *detachCompressed(Buffer *bufferMgr, CompressedPage **link)
+/* Takes the entry *link points at out of its bucket and the age list. Caller holds the cache latch. */
+{
+    CompressedPage *entry = *link;
+    *link = entry->hashNext;
+    if (entry->newer != NULL) entry->newer->older = entry->older; else bufferMgr->cc.newest = entry->older;
+    if (entry->older != NULL) entry->older->newer = entry->newer; else bufferMgr->cc.oldest = entry->newer;
+    bufferMgr->cc.bytes -= sizeof(CompressedPage) + ((entry->size > 0) ? entry->size : 0);
+    return entry;
+}
+
+static void freeCompressed(CompressedPage *entry)
+/* Frees an entry taken out of the cache. */
+{
+    free(entry->data);
+    free(entry);
+}
+
+static CacheReservation reserveCompressed(Buffer *bufferMgr, int fileId, PageNumber pageNum)
+/* Reserves an entry for a clean victim's page; fillCompressed stores the page once the pool latch
+   is released. A load of the page takes the entry, reserved or not, so a fill that comes after it
+   finds nothing and cannot bring back a copy that is no longer current. Caller holds the pool latch. */
+{
+    CacheReservation reservation = {{fileId, pageNum}, 0};
+    if (!bufferMgr->cc.enabled) return reservation;
+
+    CompressedPage *entry = malloc(sizeof(CompressedPage));
+    if (entry == NULL) return reservation;
+
+    latch(bufferMgr, &bufferMgr->cc.latch);
+    CompressedPage **link = compressedLink(bufferMgr, fileId, pageNum);
+    if (*link != NULL) freeCompressed(detachCompressed(bufferMgr, link));
+
+    CompressedPage **bucket = &bufferMgr->cc.table[hashOf(fileId, pageNum) & (bufferMgr->cc.numBuckets - 1)];
+    entry->key = reservation.key;
+    entry->stamp = ++bufferMgr->cc.stamp;
+    entry->size = -1;
+    entry->data = NULL;
+    entry->hashNext = *bucket;
+    *bucket = entry;
+    entry->newer = NULL;
+    entry->older = bufferMgr->cc.newest;
+    if (bufferMgr->cc.newest != NULL) bufferMgr->cc.newest->newer = entry; else bufferMgr->cc.oldest = entry;
+    bufferMgr->cc.newest = entry;
+    bufferMgr->cc.bytes += sizeof(CompressedPage);
+    reservation.stamp = entry->stamp;
+    unlatch(bufferMgr, &bufferMgr->cc.latch);
+
+    return reservation;
+}
+
+static void fillCompressed(Buffer *bufferMgr, const CacheReservation *reservation, const char *page)
+/* Stores the victim's page, compressed if that makes it smaller, in the entry reserved for it,
+   then drops the oldest entries while the cache is over budget. The page is compressed before
+   taking the cache latch. */
+{
+    if (reservation->stamp == 0) return;
+
+    unsigned char packed[PAGE_SIZE];
+    int size = compressPage((const unsigned char *)page, packed);
+    unsigned char *data = (size > 0) ? malloc(size) : malloc(PAGE_SIZE);
+    if (data != NULL) {
+        if (size > 0) {
+            memcpy(data, packed, size);
+        } else {
+            memcpy(data, page, PAGE_SIZE);  // Does not compress; kept raw, which still saves the read
+            size = PAGE_SIZE;
+        }
+    }
+
+    bool stored = false;
+    long drops = 0;
+    latch(bufferMgr, &bufferMgr->cc.latch);
+    CompressedPage **link = compressedLink(bufferMgr, reservation->key.fileId, reservation->key.pageNum);
+    if (*link != NULL && (*link)->stamp == reservation->stamp && (*link)->size < 0) {
+        if (data != NULL) {
+            (*link)->data = data;
+            (*link)->size = size;
+            bufferMgr->cc.bytes += size;
+            data = NULL;
+            stored = true;
+        } else {
+            freeCompressed(detachCompressed(bufferMgr, link));
+        }
+    }
+    while (bufferMgr->cc.bytes > bufferMgr->cc.budget && bufferMgr->cc.oldest != NULL) {
+        CompressedPage *oldest = bufferMgr->cc.oldest;
+        freeCompressed(detachCompressed(bufferMgr, compressedLink(bufferMgr, oldest->key.fileId, oldest->key.pageNum)));
+        drops++;
+    }
+    unlatch(bufferMgr, &bufferMgr->cc.latch);
+    free(data);
+
+    if (stored) atomic_fetch_add(&bufferMgr->cc.numStores, 1);
+    if (drops > 0) atomic_fetch_add(&bufferMgr->cc.numDrops, drops);
+}
+
+static bool takeCompressedPage(Buffer *bufferMgr, Frame *frame)
+/* Serves the read into a frame published by evictAndPublish from the compressed cache. The page's
+   entry leaves the cache either way, a bare reservation included, so the cache never holds a page
+   that is also resident. Returns whether the page came from the cache. */
+{
+    if (!bufferMgr->cc.enabled) return false;
+
+    CompressedPage *entry = NULL;
+    latch(bufferMgr, &bufferMgr->cc.latch);
+    CompressedPage **link = compressedLink(bufferMgr, frame->fileId, frame->currpage);
+    if (*link != NULL) entry = detachCompressed(bufferMgr, link);
+    unlatch(bufferMgr, &bufferMgr->cc.latch);
+
+    if (entry == NULL) return false;
+    bool taken = false;
+    if (entry->size == PAGE_SIZE) {
+        memcpy(frame->data, entry->data, PAGE_SIZE);
+        taken = true;
+    } else if (entry->size > 0) {
+        taken = decompressPage(entry->data, entry->size, (unsigned char *)frame->data);
+    }
+    freeCompressed(entry);
+
+    if (taken) atomic_fetch_add(&bufferMgr->cc.numHits, 1);
+    return taken;
+}
+
+static void dropCompressedFile(Buffer *bufferMgr, int fileId)
+/* Removes the file's entries, before its registry slot can be reused. Caller holds the pool latch. */
+{
+    if (!bufferMgr->cc.enabled) return;
+
+    latch(bufferMgr, &bufferMgr->cc.latch);
+    for (int b = 0; b < bufferMgr->cc.numBuckets; b++) {
+        CompressedPage **link = &bufferMgr->cc.table[b];
+        while (*link != NULL) {
+            if ((*link)->key.fileId == fileId) {
+                freeCompressed(detachCompressed(bufferMgr, link));
+            } else {
+                link = &(*link)->hashNext;
+            }
+        }
+    }
+    unlatch(bufferMgr, &bufferMgr->cc.latch);
+}
+
+/* Victim Selection */
+static Frame *selectStalePrefetch(Buffer *bufferMgr)
+/* Prefetched pages that were not pinned within a quarter pool's worth of loads are assumed
+   unneeded and are evicted before anything else, oldest first. Caller holds the pool latch. */
+{
+    if (atomic_load(&bufferMgr->prefetch.numUnused) == 0) return NULL;
+
+    int now = atomic_load(&bufferMgr->prefetch.loadClock);
+    int minAge = (bufferMgr->numFrames / 4 > 0) ? bufferMgr->numFrames / 4 : 1;
+    Frame *oldest = NULL;
+    Frame *currentFrame = bufferMgr->head;
+
+    do {
+        if (currentFrame->prefetched && atomic_load(&currentFrame->fixCount) == 0
+            && now - currentFrame->loadSeq >= minAge
+            && (oldest == NULL || currentFrame->loadSeq < oldest->loadSeq)) {
+            oldest = currentFrame;
+        }
+        currentFrame = currentFrame->next;
+    } while (currentFrame != bufferMgr->head);
+
+    return (oldest != NULL && claimFrame(bufferMgr, oldest)) ? oldest : NULL;
+}
+
+static Frame *selectVictimFIFO(Buffer *bufferMgr, int *steps)
+/* Picks the first unpinned frame from the head of the queue (FIFO and LRU). Under LRU, a frame
+   whose hit did not get the pool latch (see touchFrame) is moved to the tail now instead, and
+   the search goes on past the old tail until it meets the moved frames again. Caller holds the pool latch. */
+{
+    Frame *currentFrame = bufferMgr->head;
+    bool lru = (bufferMgr->strategy == RS_LRU);
+    int numMoved = 0;
+
+    for (int i = 0; i < bufferMgr->numFrames + numMoved; i++) {
+        Frame *nextFrame = currentFrame->next;
+        (*steps)++;
+        if (lru && atomic_load(&currentFrame->fixCount) == 0 && atomic_exchange(&currentFrame->usage, 0) != 0) {
+            moveToTail(bufferMgr, currentFrame);
+            numMoved++;
+        } else if (claimFrame(bufferMgr, currentFrame)) {
+            return currentFrame;
+        }
+        currentFrame = nextFrame;
+    }
+
+    return NULL;  // No available frame
+}
+
+static Frame *selectVictimCLOCK(Buffer *bufferMgr, int *steps)
+/* Sweeps frames from the clock pointer without reordering the queue (CLOCK and GCLOCK), taking
+   the first unpinned frame whose usage counter is zero and counting down the others. Gives up
+   after maxUsage + 1 rounds, or after a round that met no unpinned frame. Caller holds the pool latch. */
+{
+    Frame *currentFrame = bufferMgr->pointer;
+    int maxUsage = atomic_load(&bufferMgr->maxUsage);
+
+    for (int round = 0; round <= maxUsage; round++) {
+        bool unpinned = false;
+        for (int i = 0; i < bufferMgr->numFrames; i++) {
+            currentFrame = currentFrame->next;  // The hand's own frame comes last
+            (*steps)++;
+            if (atomic_load(&currentFrame->fixCount) != 0) continue;
+            unpinned = true;
+
+            int usage = atomic_load(&currentFrame->usage);
+            if (usage == 0) {
+                if (claimFrame(bufferMgr, currentFrame)) {
+                    return currentFrame;
+                }
+            } else {
+                // Count down during the sweep; a hit landing meanwhile keeps its increment
+                atomic_compare_exchange_strong(&currentFrame->usage, &usage, usage - 1);
+            }
+        }
+        if (!unpinned) break;
+    }
+
+    return NULL;  // No available frame
+}
+
+static int maxUsageOf(ReplacementStrategy strategy)
+/* Frame.usage ceiling: 1 for CLOCK (a reference bit), GCLOCK_MAX_USAGE for GCLOCK, 0 otherwise. */
+{
+    return (strategy == RS_GCLOCK) ? GCLOCK_MAX_USAGE : (strategy == RS_CLOCK) ? 1 : 0;
+}
+
+static bool sweptByClock(Buffer *bufferMgr)
+/* Whether the pool finds victims with the clock hand rather than from the queue head. */
+{
+    ReplacementStrategy strategy = bufferMgr->strategy;
+    return strategy == RS_CLOCK || strategy == RS_GCLOCK;
+}
+
+static void touchFrame(Buffer *bufferMgr, Frame *frame, bool latchFree)
+/* Records a hit on a resident frame for the replacement strategy. Under LRU the frame moves to
+   the tail if the pool latch is free at once; otherwise, or with latchFree (pin cache hits),
+   it is only marked, and the next victim search that reaches it moves it. A hit never waits
+   for the pool latch. */
+{
+    int maxUsage = atomic_load(&bufferMgr->maxUsage);
+
+    if (bufferMgr->strategy == RS_LRU) {
+        if (!latchFree && (!bufferMgr->threadSafe || pthread_mutex_trylock(&bufferMgr->poolLatch) == 0)) {
+            atomic_store(&frame->usage, 0);
+            moveToTail(bufferMgr, frame);
+            unlatch(bufferMgr, &bufferMgr->poolLatch);
+        } else if (atomic_load(&frame->usage) == 0) {
+            atomic_store(&frame->usage, 1);
+        }
+    } else if (maxUsage > 0) {
+        // Saturating increment without the pool latch; losing one to a racing hit or sweep is harmless
+        int usage = atomic_load(&frame->usage);
+        if (usage < maxUsage) {
+            atomic_compare_exchange_strong(&frame->usage, &usage, usage + 1);
+        }
+    }
+}
+
+static void placeFrame(Buffer *bufferMgr, Frame *frame)
+/* Positions a freshly loaded frame for the replacement strategy. Caller holds the pool latch. */
+{
+    if (sweptByClock(bufferMgr)) {
+        atomic_store(&frame->usage, 0);  // Not used yet; the hand reaches it last anyway
+        bufferMgr->pointer = frame;  // Update the CLOCK pointer
+    } else {
+        atomic_store(&frame->usage, 0);  // No hit waiting to move it under LRU
+        moveToTail(bufferMgr, frame);  // FIFO and LRU queue the frame at the tail
+    }
+}
+
+static Frame *selectVictim(Buffer *bufferMgr)
+/* Claims a victim frame for the pool's replacement strategy. Caller holds the pool latch. */
+{
+    Frame *victim = selectStalePrefetch(bufferMgr);
+    if (victim != NULL) return victim;
+
+    int steps = 0;
+    victim = sweptByClock(bufferMgr) ? selectVictimCLOCK(bufferMgr, &steps)
+                                     : selectVictimFIFO(bufferMgr, &steps);
+
+    // Histogram bucket i holds searches of (2^(i-1), 2^i] frames
+    int bucket = 0;
+    while (bucket < BM_SEARCH_BUCKETS - 1 && (1 << bucket) < steps) bucket++;
+    atomic_fetch_add(&bufferMgr->stats.numSearches, 1);
+    atomic_fetch_add(&bufferMgr->stats.numSearchSteps, steps);
+    atomic_fetch_add(&bufferMgr->stats.searchLength[bucket], 1);
+    return victim;
+}
+
+static void addToRing(BM_AccessRing *ring, int fileId, PageNumber pageNum)
+/* Records a page the ring's caller brought in, replacing the oldest slot. */
+{
+    ring->slots[ring->next].fileId = fileId;
+    ring->slots[ring->next].pageNum = pageNum;
+    ring->next = (ring->next + 1) % ring->size;
+}
+
+static bool ringHolds(const BM_AccessRing *ring, int fileId, PageNumber pageNum)
+/* Whether the page is one of those the ring records. */
+{
+    for (int i = 0; i < ring->size; i++) {
+        if (ring->slots[i].pageNum == pageNum && ring->slots[i].fileId == fileId) return true;
+    }
+    return false;
+}
+
+static Frame *selectRingVictim(Buffer *bufferMgr, BM_AccessRing *ring)
+/* Claims the frame holding the ring's oldest page, if that page is still resident and nobody
+   has it pinned or (for CLOCK and GCLOCK) hit since. Caller holds the pool latch. */
+{
+    PageKey key = ring->slots[ring->next];
+    if (key.fileId < 0) return NULL;  // The ring is still filling up
+
+    int part = partitionOf(bufferMgr, key.fileId, key.pageNum);
+    latch(bufferMgr, &bufferMgr->partLatch[part]);
+    Frame *frame = lookupFrame(bufferMgr, key.fileId, key.pageNum);
+    unlatch(bufferMgr, &bufferMgr->partLatch[part]);
+
+    if (frame == NULL || atomic_load(&frame->usage) > 0) return NULL;
+    return claimFrame(bufferMgr, frame) ? frame : NULL;
+}
+
+static void rememberEvicted(Buffer *bufferMgr, Frame *frame)
+/* Adds the page a frame is giving up to the pool's ghosts, replacing the oldest. Caller holds the pool latch. */
+{
+    bufferMgr->governor.ghosts[bufferMgr->governor.ghostNext].fileId = frame->fileId;
+    bufferMgr->governor.ghosts[bufferMgr->governor.ghostNext].pageNum = frame->currpage;
+    bufferMgr->governor.ghostNext = (bufferMgr->governor.ghostNext + 1) % GOVERNOR_STEP_PAGES;
+}
+
+static void countGhostHit(Buffer *bufferMgr, int fileId, PageNumber pageNum)
+/* Counts a miss on one of the pool's ghosts, and forgets the ghost so it counts once.
+   Caller holds the pool latch. */
+{
+    for (int i = 0; i < GOVERNOR_STEP_PAGES; i++) {
+        if (bufferMgr->governor.ghosts[i].pageNum == pageNum && bufferMgr->governor.ghosts[i].fileId == fileId) {
+            bufferMgr->governor.ghosts[i].pageNum = NO_PAGE;
+            atomic_fetch_add(&bufferMgr->governor.numGhostHits, 1);
+            return;
+        }
+    }
+}
+
+static RC handOffDirtyPage(Buffer *bufferMgr, Frame *frame, WriteBack *writeBack, bool *queued)
+/* Takes the write of a claimed frame's dirty page off the caller: it is queued with write-behind,
+   otherwise entered in writeBack, which the caller writes with finishWriteBack once it has let go
+   of the pool latch. Misses on the page wait for that write, so nobody re-reads a stale copy.
+   Either way the frame is clean afterwards; a clean frame is left alone. Scratch pages stay out
+   of the queue. On failure the claim is released. Caller holds the pool latch and keeps it. */
+{
+    RC resultCode = RC_OK;
+    writeBack->key.pageNum = NO_PAGE;
+
+    // With write-behind the dirty page is handed to the queue; a full queue falls back to writing here
+    *queued = frame->dirty && bufferMgr->wb.enabled && frame->fileId != SCRATCH_FILE && queueWrite(bufferMgr, frame);
+
+    if (*queued) {
+        clearDirty(bufferMgr, frame);  // The queue owns the write now
+    } else if (frame->dirty) {
+        if (frame->fileId == SCRATCH_FILE) {
+            resultCode = openScratchFile(bufferMgr);
+        }
+        if (resultCode != RC_OK) {
+            releaseClaim(bufferMgr, frame);
+            return resultCode;
+        }
+        if (frame->fileId == SCRATCH_FILE) {
+            bufferMgr->scratch.state[frame->currpage] = SCRATCH_SPILLED;  // Read back only after the write-back
+        }
+        writeBack->key.fileId = frame->fileId;
+        writeBack->key.pageNum = frame->currpage;
+        latch(bufferMgr, &bufferMgr->writeBacks.latch);
+        writeBack->next = bufferMgr->writeBacks.list;
+        bufferMgr->writeBacks.list = writeBack;
+        unlatch(bufferMgr, &bufferMgr->writeBacks.latch);
+        clearDirty(bufferMgr, frame);  // The write-back owns the write now
+    }
+    return RC_OK;
+}
+
+static RC evictAndPublish(Buffer *bufferMgr, Frame *frame, int fileId, PageNumber pageNum, bool prefetch,
+                          CacheReservation *reservation, WriteBack *writeBack)
+/* Assigns a claimed frame to pageNum of the file and publishes it as I/O-in-progress.
+   The old dirty page, which may belong to another file, goes to handOffDirtyPage; the caller
+   writes it with finishWriteBack, if it has to, before reading into the frame. Finish the read
+   with completeRead.
+   With the compressed cache, the old page, clean once written, gets a reservation the caller fills
+   from the frame before reading into it. Scratch pages stay out of the queue and the cache.
+   A prefetch leaves the frame unpinned and flagged as prefetched.
+   On failure the claim is released. Caller holds the pool latch and keeps it. */
+{
+    bool dirty = frame->dirty, queued;
+    reservation->stamp = 0;
+
+    RC resultCode = handOffDirtyPage(bufferMgr, frame, writeBack, &queued);
+    if (resultCode != RC_OK) {
+        return resultCode;
+    }
+
+    if (frame->currpage != NO_PAGE) {
+        atomic_fetch_add(&bufferMgr->stats.numEvictions, 1);
+        if (!dirty) {
+            atomic_fetch_add(&bufferMgr->stats.numCleanEvictions, 1);
+        } else if (bufferMgr->writer.on && !queued) {
+            // The background writer fell behind; run a round now rather than at the next tick
+            pthread_mutex_lock(&bufferMgr->writer.latch);
+            pthread_cond_signal(&bufferMgr->writer.wakeup);
+            pthread_mutex_unlock(&bufferMgr->writer.latch);
+        }
+    }
+
+    if (frame->currpage != NO_PAGE && !queued && frame->fileId != SCRATCH_FILE) {
+        *reservation = reserveCompressed(bufferMgr, frame->fileId, frame->currpage);
+    }
+    if (!prefetch) countGhostHit(bufferMgr, fileId, pageNum);
+    if (frame->currpage != NO_PAGE) rememberEvicted(bufferMgr, frame);
+
+    // Publish the frame under its new page before reading, so concurrent misses wait for this read
+    int part = partitionOf(bufferMgr, fileId, pageNum);
+    latch(bufferMgr, &bufferMgr->partLatch[part]);
+    if (frame->prefetched) {
+        atomic_fetch_add(&bufferMgr->prefetch.numWasted, 1);  // Evicted without ever being pinned
+        atomic_fetch_sub(&bufferMgr->prefetch.numUnused, 1);
+    }
+    frame->prefetched = prefetch;
+    if (prefetch) {
+        atomic_fetch_add(&bufferMgr->prefetch.numUnused, 1);
+    }
+    atomic_fetch_add(&frame->version, 1);  // Odd until completeRead: optimistic readers back off
+    frame->loadSeq = atomic_fetch_add(&bufferMgr->prefetch.loadClock, 1);
+    frame->currpage = pageNum;       // Update frame with the new page number
+    frame->fileId = fileId;
+    atomic_fetch_add(&frame->fixCount, prefetch ? 0 : 1);  // Not a store: a pin cache may be backing off a pin
+    frame->ioInProgress = true;
+    insertFrame(bufferMgr, frame);
+    unlatch(bufferMgr, &bufferMgr->partLatch[part]);
+
+    placeFrame(bufferMgr, frame);
+    return RC_OK;
+}
+
+static void completeRead(Buffer *bufferMgr, Frame *frame, RC readResult, bool fromDisk)
+/* Ends the read into a frame published by evictAndPublish and wakes anyone waiting for it.
+   fromDisk is false for a page copied from the write-behind queue, which costs no read I/O.
+   A failed read gives the frame up, dropping the pin of a non-prefetch load. */
+{
+    int part = partitionOf(bufferMgr, frame->fileId, frame->currpage);
+
+    latch(bufferMgr, &bufferMgr->partLatch[part]);
+    if (readResult == RC_OK) {
+        if (fromDisk) atomic_fetch_add(&bufferMgr->numRead, 1);  // Increment read count
+        if (frame->prefetched) atomic_fetch_add(&bufferMgr->prefetch.numPrefetches, 1);
+    } else {
+        // Give the frame up; waiters notice the page is gone and retry
+        removeFrame(bufferMgr, frame);
+        if (frame->prefetched) {
+            frame->prefetched = false;
+            atomic_fetch_sub(&bufferMgr->prefetch.numUnused, 1);
+        } else {
+            atomic_fetch_sub(&frame->fixCount, 1);
+        }
+        frame->currpage = NO_PAGE;
+    }
+    frame->ioInProgress = false;
+    atomic_fetch_add(&frame->version, 1);  // Stable again
+    if (bufferMgr->threadSafe) pthread_cond_broadcast(&bufferMgr->ioDone[part]);
+    unlatch(bufferMgr, &bufferMgr->partLatch[part]);
+}
+
+static RC finishWriteBack(Buffer *bufferMgr, Frame *frame, WriteBack *writeBack)
+/* Writes the old page of a frame evictAndPublish entered in writeBack, before the caller reads
+   into the frame; does nothing if there was none. Called without the pool latch. If the write
+   fails the load fails too: the frame goes back to the old page, still dirty, and misses waiting
+   for the new page retry. */
+{
+    PageKey key = writeBack->key;
+    if (key.pageNum == NO_PAGE) return RC_OK;
+
+    RC resultCode = writePage(bufferMgr, key.fileId, key.pageNum, frame->data);
+    if (resultCode == RC_OK) {
+        atomic_fetch_add(&bufferMgr->numWrite, 1);
+        if (key.fileId == SCRATCH_FILE) atomic_fetch_add(&bufferMgr->scratch.numSpills, 1);
+    } else {
+        // The extra pin keeps victim searches off the frame until it holds the old page again.
+        // No pool latch here: dropFileFrames waits for this frame's read holding it.
+        atomic_fetch_add(&frame->fixCount, 1);
+        completeRead(bufferMgr, frame, resultCode, false);
+        int part = partitionOf(bufferMgr, key.fileId, key.pageNum);
+        latch(bufferMgr, &bufferMgr->partLatch[part]);
+        frame->fileId = key.fileId;
+        frame->currpage = key.pageNum;
+        insertFrame(bufferMgr, frame);
+        unlatch(bufferMgr, &bufferMgr->partLatch[part]);
+        setDirty(bufferMgr, frame);
+        atomic_fetch_sub(&frame->fixCount, 1);
+    }
+
+    latch(bufferMgr, &bufferMgr->writeBacks.latch);
+    WriteBack **link = &bufferMgr->writeBacks.list;
+    while (*link != writeBack) {
+        link = &(*link)->next;
+    }
+    *link = writeBack->next;
+    if (bufferMgr->threadSafe) pthread_cond_broadcast(&bufferMgr->writeBacks.done);
+    unlatch(bufferMgr, &bufferMgr->writeBacks.latch);
+    return resultCode;
+}
+
+static RC pinScratchFrame(Buffer *bufferMgr, Frame *frame, PageNumber pageNum)
+/* pinThispage for a scratch page: reads its last spilled copy back from the temp file, or zeros
+   if it was never spilled. Fails with RC_READ_NON_EXISTING_PAGE for a page number not allocated.
+   Caller holds the pool latch; it is released on return. */
+{
+    CacheReservation reservation;
+    WriteBack writeBack;
+    RC resultCode = RC_READ_NON_EXISTING_PAGE;
+    bool spilled = false;
+
+    if (pageNum < bufferMgr->scratch.end && bufferMgr->scratch.state[pageNum] != SCRATCH_FREE) {
+        spilled = bufferMgr->scratch.state[pageNum] == SCRATCH_SPILLED;
+        resultCode = evictAndPublish(bufferMgr, frame, SCRATCH_FILE, pageNum, false, &reservation, &writeBack);
+    } else {
+        releaseClaim(bufferMgr, frame);
+    }
+    int fd = spilled ? fileno(bufferMgr->scratch.file) : -1;
+    unlatch(bufferMgr, &bufferMgr->poolLatch);
+    if (resultCode != RC_OK) return resultCode;
+
+    resultCode = finishWriteBack(bufferMgr, frame, &writeBack);
+    if (resultCode != RC_OK) return resultCode;
+    fillCompressed(bufferMgr, &reservation, frame->data);
+    if (!spilled) {
+        memset(frame->data, 0, PAGE_SIZE);
+    } else if (pread(fd, frame->data, PAGE_SIZE, (off_t) pageNum * PAGE_SIZE) != PAGE_SIZE) {
+        resultCode = RC_READ_NON_EXISTING_PAGE;
+    }
+
+    completeRead(bufferMgr, frame, resultCode, spilled);
+    return resultCode;
+}
+
+static RC openForLoad(Buffer *bufferMgr, int fileId, PageNumber lastPage, bool extend, SM_FileHandle *fileHandle)
+/* Opens the file to read pages up to lastPage. With extend, a file that is too short is grown
+   first, one extension at a time and on a freshly opened handle, since appending starts at the
+   file's current end: two misses past the end would otherwise both append. Without it, a page
+   past the end fails with RC_READ_NON_EXISTING_PAGE. Called without the pool latch, from a load
+   whose frame is published as I/O-in-progress or on behalf of a handle on the file, so the file
+   cannot be detached meanwhile. */
+{
+    RC resultCode = openPageFile(bufferMgr->files[fileId].name, fileHandle);
+    if (resultCode != RC_OK || lastPage < fileHandle->totalNumPages) return resultCode;
+    if (!extend) {
+        closePageFile(fileHandle);
+        return RC_READ_NON_EXISTING_PAGE;
+    }
+
+    latch(bufferMgr, &bufferMgr->extendLatch);
+    closePageFile(fileHandle);
+    resultCode = openPageFile(bufferMgr->files[fileId].name, fileHandle);
+    if (resultCode == RC_OK) {
+        resultCode = ensureCapacity(lastPage + 1, fileHandle);
+        if (resultCode != RC_OK) closePageFile(fileHandle);
+    }
+    unlatch(bufferMgr, &bufferMgr->extendLatch);
+    return resultCode;
+}
+
+int pinThispage(Buffer *bufferMgr, Frame *frame, int fileId, PageNumber pageNum, bool prefetch)
+/* Pins the specified pageNum of the file to the given (claimed) frame. The frame is published
+   under the pool latch; the victim's dirty page is written back, and the file opened, extended
+   and read, after the latch is released.
+   A prefetch never extends the file and leaves the frame unpinned and flagged as prefetched.
+   Caller holds the pool latch; it is released on return. */
+{
+    SM_FileHandle fileHandle;
+    CacheReservation reservation;
+    WriteBack writeBack;
+    RC resultCode;
+
+    if (fileId == SCRATCH_FILE) {
+        return pinScratchFrame(bufferMgr, frame, pageNum);
+    }
+
+    resultCode = evictAndPublish(bufferMgr, frame, fileId, pageNum, prefetch, &reservation, &writeBack);
+    unlatch(bufferMgr, &bufferMgr->poolLatch);
+    if (resultCode != RC_OK) {
+        return resultCode;
+    }
+    resultCode = finishWriteBack(bufferMgr, frame, &writeBack);
+    if (resultCode != RC_OK) {
+        return resultCode;
+    }
+
+    // Keep the old page, then read the new one unless it waits in the write-behind queue or the compressed cache
+    fillCompressed(bufferMgr, &reservation, frame->data);
+    resultCode = openForLoad(bufferMgr, fileId, pageNum, !prefetch, &fileHandle);
+    if (resultCode != RC_OK) {
+        completeRead(bufferMgr, frame, resultCode, false);
+        return resultCode;
+    }
+    bool fromDisk = !takeQueuedPage(bufferMgr, frame) && !takeCompressedPage(bufferMgr, frame);
+    if (fromDisk) {
+        resultCode = readBlock(pageNum, &fileHandle, frame->data);
+    }
+    closePageFile(&fileHandle);      // Close the page file
+
+    completeRead(bufferMgr, frame, resultCode, fromDisk);
+    return resultCode;
+}
+
+static void recordPin(Buffer *bufferMgr, const struct timespec *start, bool hit)
+/* Counts a successful pin and adds its latency since start to the hit or miss histogram. */
+{
+    struct timespec end;
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    long micros = (end.tv_sec - start->tv_sec) * 1000000L + (end.tv_nsec - start->tv_nsec) / 1000;
+
+    // Bucket 0 is below 1us, bucket i covers [2^(i-1), 2^i) us
+    int bucket = 0;
+    while (bucket < BM_LATENCY_BUCKETS - 1 && (1L << bucket) <= micros) bucket++;
+
+    if (hit) {
+        atomic_fetch_add(&bufferMgr->stats.numHits, 1);
+        atomic_fetch_add(&bufferMgr->stats.hitLatency[bucket], 1);
+    } else {
+        atomic_fetch_add(&bufferMgr->stats.numMisses, 1);
+        atomic_fetch_add(&bufferMgr->stats.missLatency[bucket], 1);
+    }
+}
+
+static Frame *pinFromCache(Buffer *bufferMgr, int fileId, PageNumber pageNum)
+/* Pins the page through the calling thread's pin cache, with neither a page table lookup nor a
+   latch. Returns NULL unless the thread pinned the page recently and its frame still holds it.
+   The pin is taken before the residency is compared, and whoever takes a frame's page away
+   bumps the residency before checking the fix count, so either the claim sees this pin or
+   this pin sees the claim and is given back. */
+{
+    PinCacheEntry *entry = &pinCache[hashOf(fileId, pageNum) % PIN_CACHE_SLOTS];
+    if (entry->poolSerial != bufferMgr->poolSerial || entry->fileId != fileId || entry->pageNum != pageNum) {
+        return NULL;
+    }
+
+    Frame *frame = entry->frame;
+    atomic_fetch_add(&frame->fixCount, 1);
+    if (atomic_load(&frame->residency) != entry->residency) {
+        atomic_fetch_sub(&frame->fixCount, 1);
+        entry->poolSerial = 0;  // The page was evicted, or nearly; forget it
+        return NULL;
+    }
+    entry->referenced = true;
+    atomic_fetch_add(&bufferMgr->stats.numPinCacheHits, 1);
+    return frame;
+}
+
+static void rememberPin(Buffer *bufferMgr, Frame *frame, int fileId, PageNumber pageNum)
+/* Records a pin in the calling thread's pin cache. A page re-pinned through its entry since the
+   last attempt is given a second chance, like CLOCK, so one-off pins do not push out the pages
+   a thread keeps coming back to (a B+-tree root, a table's first page).
+   The thread holds the pin, so the frame keeps the page while its residency is read. */
+{
+    PinCacheEntry *entry = &pinCache[hashOf(fileId, pageNum) % PIN_CACHE_SLOTS];
+    bool samePage = entry->poolSerial == bufferMgr->poolSerial && entry->fileId == fileId
+                    && entry->pageNum == pageNum;
+    if (!samePage && entry->poolSerial != 0 && entry->referenced) {
+        entry->referenced = false;
+        return;
+    }
+    if (!samePage) entry->referenced = false;
+    entry->poolSerial = bufferMgr->poolSerial;
+    entry->fileId = fileId;
+    entry->pageNum = pageNum;
+    entry->frame = frame;
+    entry->residency = atomic_load(&frame->residency);
+}
+
+RC pinWithStrategy(Buffer *bufferMgr, int fileId, BM_PageHandle *const page, const PageNumber pageNum,
+                   BM_AccessRing *ring)
+/* Pins the page of the file, loading it into a victim chosen by the pool's replacement strategy on a miss.
+   With a ring, a miss first recycles the frame of the ring's oldest page, and hits do not
+   promote the frame in the replacement order, nor use the pin cache. */
+{
+    bool prefetchHit = false;
+    bool useCache = bufferMgr->pinCache && ring == NULL;
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    Frame *frame = useCache ? pinFromCache(bufferMgr, fileId, pageNum) : NULL;
+    bool cacheHit = (frame != NULL);
+    if (frame == NULL) {
+        frame = alreadyPinned(bufferMgr, fileId, pageNum, &prefetchHit);
+    }
+
+    if (frame == NULL) {
+        latch(bufferMgr, &bufferMgr->poolLatch);
+
+        // Another thread may have loaded the page while we waited for the pool latch
+        frame = alreadyPinned(bufferMgr, fileId, pageNum, &prefetchHit);
+        if (frame == NULL && writeBackPending(bufferMgr, fileId, pageNum)) {
+            // The page is being written out of the frame it was evicted from; read it once it is on disk
+            unlatch(bufferMgr, &bufferMgr->poolLatch);
+            waitForWriteBack(bufferMgr, fileId, pageNum);
+            return pinWithStrategy(bufferMgr, fileId, page, pageNum, ring);
+        }
+        if (frame == NULL) {
+            Frame *victim = (ring != NULL) ? selectRingVictim(bufferMgr, ring) : NULL;
+            if (victim == NULL) {
+                victim = selectVictim(bufferMgr);
+            }
+            if (victim == NULL) {
+                unlatch(bufferMgr, &bufferMgr->poolLatch);
+                return RC_IM_NO_MORE_ENTRIES;  // No available frame
+            }
+
+            RC resultCode = pinThispage(bufferMgr, victim, fileId, pageNum, false);
+            if (resultCode != RC_OK) return resultCode;
+
+            if (ring != NULL) {
+                addToRing(ring, fileId, pageNum);
+            } else if (useCache) {
+                rememberPin(bufferMgr, victim, fileId, pageNum);
+            }
+            recordPin(bufferMgr, &start, false);
+
+            page->pageNum = pageNum;
+            page->data = victim->data;
+            page->frameRef = victim;
+            return RC_OK;
+        }
+        unlatch(bufferMgr, &bufferMgr->poolLatch);
+    }
+
+    if (useCache) {
+        rememberPin(bufferMgr, frame, fileId, pageNum);
+    }
+    if (ring == NULL) {
+        touchFrame(bufferMgr, frame, cacheHit);
+    } else if (prefetchHit && !ringHolds(ring, fileId, pageNum)) {
+        addToRing(ring, fileId, pageNum);  // Read ahead for this caller, so recycle it like a miss
+    }
+    recordPin(bufferMgr, &start, true);
+    page->pageNum = pageNum;
+    page->data = frame->data;
+    page->frameRef = frame;
+    return RC_OK;
+}
+
+/* Background Writer */
+static int pinForFlush(Buffer *bufferMgr, Frame *frame, bool pinnedToo)
+/* Pins a dirty frame so it can be written without being evicted meanwhile. The background
+   writer leaves frames in use alone; flushes write them too (pinnedToo).
+   The dirty flag is cleared here; a writer pinning the page afterwards sets it again with markDirty.
+   Caller holds the pool latch, so the frame keeps its page. */
+{
+    if (frame->currpage == NO_PAGE || !frame->dirty || (!pinnedToo && atomic_load(&frame->fixCount) != 0)) return 0;
+
+    int part = partitionOf(bufferMgr, frame->fileId, frame->currpage);
+    int pinned = 0;
+
+    latch(bufferMgr, &bufferMgr->partLatch[part]);
+    if (frame->dirty && (pinnedToo || atomic_load(&frame->fixCount) == 0) && !frame->ioInProgress) {
+        atomic_fetch_add(&frame->fixCount, 1);
+        clearDirty(bufferMgr, frame);
+        pinned = 1;
+    }
+    unlatch(bufferMgr, &bufferMgr->partLatch[part]);
+
+    return pinned;
+}
+
+static void backgroundWriterRound(Buffer *bufferMgr)
+/* Writes dirty unpinned frames in eviction order until the clean share of unpinned frames
+   reaches the high watermark. Only a round below the low watermark writes anything.
+   Holds the flush latch throughout so no file is detached under a pinned frame. */
+{
+    Frame **batch = malloc(sizeof(Frame *) * bufferMgr->writer.maxPages);
+    int batchSize = 0;
+    int unpinned = 0, clean = 0;
+
+    if (batch == NULL) return;
+
+    pthread_mutex_lock(&bufferMgr->flushLatch);
+    latch(bufferMgr, &bufferMgr->poolLatch);
+    Frame *currentFrame = bufferMgr->head;
+    do {
+        if (atomic_load(&currentFrame->fixCount) == 0) {
+            unpinned++;
+            if (!currentFrame->dirty) clean++;
+        }
+        currentFrame = currentFrame->next;
+    } while (currentFrame != bufferMgr->head);
+
+    if (unpinned > 0 && clean < unpinned * bufferMgr->writer.lowWater) {
+        int wanted = (int)(unpinned * bufferMgr->writer.highWater + 0.5) - clean;
+
+        // Walk frames in the order the strategy will evict them
+        Frame *start = sweptByClock(bufferMgr) ? bufferMgr->pointer->next : bufferMgr->head;
+        currentFrame = start;
+        do {
+            if (batchSize < wanted && batchSize < bufferMgr->writer.maxPages
+                && currentFrame->fileId != SCRATCH_FILE  // Spilled only if evicted; it may be freed first
+                && pinForFlush(bufferMgr, currentFrame, false)) {
+                batch[batchSize++] = currentFrame;
+            }
+            currentFrame = currentFrame->next;
+        } while (currentFrame != start);
+    }
+    unlatch(bufferMgr, &bufferMgr->poolLatch);
+
+    // Write outside the pool latch so misses are never held up by this I/O.
+    // Consecutive frames of the same file share one open handle.
+    SM_FileHandle fileHandle;
+    int openFile = -1;
+
+    for (int i = 0; i < batchSize; i++) {
+        Frame *frame = batch[i];
+        if (frame->fileId != openFile) {
+            if (openFile >= 0) closePageFile(&fileHandle);
+            openFile = (openPageFile(bufferMgr->files[frame->fileId].name, &fileHandle) == RC_OK)
+                       ? frame->fileId : -1;
+        }
+        // A writer may have pinned and latched the page since; never wait for it here
+        bool latched = pthread_rwlock_tryrdlock(&frame->pageLatch) == 0;
+        if (latched && openFile >= 0 && writeBlock(frame->currpage, &fileHandle, frame->data) == RC_OK) {
+            atomic_fetch_add(&bufferMgr->numWrite, 1);
+            atomic_fetch_add(&bufferMgr->writer.numWrites, 1);
+        } else {
+            setDirty(bufferMgr, frame);  // Try again next round
+        }
+        if (latched) pthread_rwlock_unlock(&frame->pageLatch);
+        atomic_fetch_sub(&frame->fixCount, 1);
+    }
+    if (openFile >= 0) closePageFile(&fileHandle);
+    pthread_mutex_unlock(&bufferMgr->flushLatch);
+
+    free(batch);
+}
+
+/* Warm restart */
+static char *hotListName(const char *pageFileName, const char *extra)
+/* <pageFileName>.hot followed by extra, in a new string. */
+{
+    char *name = malloc(strlen(pageFileName) + strlen(HOT_PAGES_SUFFIX) + strlen(extra) + 1);
+    if (name != NULL) {
+        strcpy(name, pageFileName);
+        strcat(name, HOT_PAGES_SUFFIX);
+        strcat(name, extra);
+    }
+    return name;
+}
+
+static RC saveHotList(Buffer *bufferMgr, int fileId)
+/* Writes the file's resident pages, most recently loaded or used first, to <file>.hot: a page
+   count followed by the page numbers. The list is written to a temporary file and renamed, so a
+   crash leaves the previous list intact. Caller holds the flush latch, so the file stays attached. */
+{
+    int count = 0;
+
+    latch(bufferMgr, &bufferMgr->poolLatch);
+    if (bufferMgr->files[fileId].name == NULL) {
+        unlatch(bufferMgr, &bufferMgr->poolLatch);
+        return RC_FILE_HANDLE_NOT_INIT;
+    }
+    PageNumber *pages = malloc(sizeof(PageNumber) * bufferMgr->numFrames);
+    char *fileName = hotListName(bufferMgr->files[fileId].name, "");
+    char *tmpName = hotListName(bufferMgr->files[fileId].name, ".tmp");
+    if (pages != NULL) {
+        // Walk backwards from the newest position: the queue tail, or the clock hand
+        Frame *start = sweptByClock(bufferMgr) ? bufferMgr->pointer : bufferMgr->tail;
+        Frame *currentFrame = start;
+        do {
+            if (currentFrame->fileId == fileId && currentFrame->currpage != NO_PAGE
+                && !currentFrame->prefetched) {
+                pages[count++] = currentFrame->currpage;
+            }
+            currentFrame = currentFrame->prev;
+        } while (currentFrame != start);
+    }
+    unlatch(bufferMgr, &bufferMgr->poolLatch);
+
+    RC resultCode = RC_WRITE_FAILED;
+    FILE *hotFile = (pages != NULL && fileName != NULL && tmpName != NULL) ? fopen(tmpName, "wb") : NULL;
+    if (hotFile != NULL) {
+        bool written = fwrite(&count, sizeof(int), 1, hotFile) == 1
+                       && fwrite(pages, sizeof(PageNumber), count, hotFile) == (size_t)count;
+        if (fclose(hotFile) == 0 && written && rename(tmpName, fileName) == 0) {
+            resultCode = RC_OK;
+        } else {
+            remove(tmpName);
+        }
+    }
+
+    free(pages);
+    free(fileName);
+    free(tmpName);
+    return resultCode;
+}
+
+static void saveAllHotLists(Buffer *bufferMgr)
+/* Periodic save from the background thread: rewrites the hot-page list of every attached file. */
+{
+    pthread_mutex_lock(&bufferMgr->flushLatch);
+    for (int f = 0; f < MAX_POOL_FILES; f++) {
+        saveHotList(bufferMgr, f);  // Skips free slots; otherwise best effort, the next round tries again
+    }
+    pthread_mutex_unlock(&bufferMgr->flushLatch);
+}
+
+static int comparePageNumbers(const void *a, const void *b)
+/* qsort order for page numbers. */
+{
+    PageNumber pa = *(const PageNumber *)a;
+    PageNumber pb = *(const PageNumber *)b;
+    return (pa > pb) - (pa < pb);
+}
+
+static void preloadHotList(BM_BufferPool *const bm)
+/* Reads the hottest pool's worth of pages listed in <file>.hot before the caller starts pinning.
+   They are loaded in page order through pinPages, so runs of consecutive pages are read together,
+   and then moved to the queue tail coldest first so the replacement order matches the saved one.
+   Pages past the end of the file are skipped. A missing or unreadable list is not an error. */
+{
+    Buffer *bufferMgr = bufferOf(bm);
+    SM_FileHandle fileHandle;
+    int count = 0, numPages = 0;
+
+    char *fileName = hotListName(bm->pageFile, "");
+    FILE *hotFile = (fileName != NULL) ? fopen(fileName, "rb") : NULL;
+    free(fileName);
+    if (hotFile == NULL) return;
+    if (fread(&count, sizeof(int), 1, hotFile) != 1 || count <= 0) {
+        fclose(hotFile);
+        return;
+    }
+    if (count > bufferMgr->numFrames) count = bufferMgr->numFrames;
+
+    PageNumber *hot = malloc(sizeof(PageNumber) * count);
+    PageNumber *sorted = malloc(sizeof(PageNumber) * count);
+    BM_PageHandle *handles = malloc(sizeof(BM_PageHandle) * PRELOAD_BATCH_PAGES);
+    if (hot != NULL) count = (int)fread(hot, sizeof(PageNumber), count, hotFile);
+    fclose(hotFile);
+
+    if (hot != NULL && sorted != NULL && handles != NULL
+        && openPageFile(bm->pageFile, &fileHandle) == RC_OK) {
+        for (int i = 0; i < count; i++) {
+            if (hot[i] >= 0 && hot[i] < fileHandle.totalNumPages) sorted[numPages++] = hot[i];
+        }
+        closePageFile(&fileHandle);
+        qsort(sorted, numPages, sizeof(PageNumber), comparePageNumbers);
+
+        for (int i = 0; i < numPages; i += PRELOAD_BATCH_PAGES) {
+            int batch = (numPages - i < PRELOAD_BATCH_PAGES) ? numPages - i : PRELOAD_BATCH_PAGES;
+            if (pinPages(bm, handles, sorted + i, batch) != RC_OK) break;  // Pool busy; stay partly warm
+            unpinPages(bm, handles, batch);
+        }
+
+        if (!sweptByClock(bufferMgr)) {
+            int fileId = fileOf(bm);
+            latch(bufferMgr, &bufferMgr->poolLatch);
+            for (int i = count - 1; i >= 0; i--) {
+                int part = partitionOf(bufferMgr, fileId, hot[i]);
+                latch(bufferMgr, &bufferMgr->partLatch[part]);
+                Frame *frame = lookupFrame(bufferMgr, fileId, hot[i]);
+                unlatch(bufferMgr, &bufferMgr->partLatch[part]);
+                if (frame != NULL) moveToTail(bufferMgr, frame);
+            }
+            unlatch(bufferMgr, &bufferMgr->poolLatch);
+        }
+    }
+
+    free(hot);
+    free(sorted);
+    free(handles);
+}
+
+static long millisSince(const struct timespec *start)
+/* Milliseconds elapsed on the monotonic clock since start. */
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (now.tv_sec - start->tv_sec) * 1000L + (now.tv_nsec - start->tv_nsec) / 1000000L;
+}
+
+static void *backgroundWriterMain(void *arg)
+/* Thread body: runs a round every writer.delayMs, or sooner when woken, until asked to stop.
+   A round writes the write-behind queue as one batch and, with backgroundWriter, dirty frames ahead of eviction.
+   Also saves the hot-page lists every hot.intervalMs; with only that enabled it sleeps
+   for that interval and writes no pages. */
+{
+    Buffer *bufferMgr = arg;
+    int delayMs = (bufferMgr->writer.rounds || bufferMgr->wb.enabled) ? bufferMgr->writer.delayMs
+                                                                      : bufferMgr->hot.intervalMs;
+    struct timespec lastSave;
+    clock_gettime(CLOCK_MONOTONIC, &lastSave);
+
+    pthread_mutex_lock(&bufferMgr->writer.latch);
+    while (!bufferMgr->writer.stop) {
+        struct timespec deadline;
+        clock_gettime(CLOCK_REALTIME, &deadline);
+        deadline.tv_sec += delayMs / 1000;
+        deadline.tv_nsec += (long)(delayMs % 1000) * 1000000L;
+        if (deadline.tv_nsec >= 1000000000L) {
+            deadline.tv_sec++;
+            deadline.tv_nsec -= 1000000000L;
+        }
+        pthread_cond_timedwait(&bufferMgr->writer.wakeup, &bufferMgr->writer.latch, &deadline);
+        if (bufferMgr->writer.stop) break;
+
+        pthread_mutex_unlock(&bufferMgr->writer.latch);
+        drainWriteBehind(bufferMgr);  // Best effort; failed pages stay queued for the next round
+        if (bufferMgr->writer.rounds) {
+            backgroundWriterRound(bufferMgr);
+        }
+        if (bufferMgr->hot.intervalMs > 0 && millisSince(&lastSave) >= bufferMgr->hot.intervalMs) {
+            saveAllHotLists(bufferMgr);
+            clock_gettime(CLOCK_MONOTONIC, &lastSave);
+        }
+        pthread_mutex_lock(&bufferMgr->writer.latch);
+    }
+    pthread_mutex_unlock(&bufferMgr->writer.latch);
+
+    return NULL;
+}
+
+static void stopBackgroundWriter(Buffer *bufferMgr)
+/* Stops and joins the background writer if it is running. */
+{
+    if (!bufferMgr->writer.on) return;
+
+    pthread_mutex_lock(&bufferMgr->writer.latch);
+    bufferMgr->writer.stop = true;
+    pthread_cond_signal(&bufferMgr->writer.wakeup);
+    pthread_mutex_unlock(&bufferMgr->writer.latch);
+    pthread_join(bufferMgr->writer.thread, NULL);
+    bufferMgr->writer.on = false;
+}
+
+/* Prefetching */
+static void prefetchOne(Buffer *bufferMgr, int fileId, const PageNumber pageNum, BM_AccessRing *ring)
+/* Reads pageNum of the file into a free or evictable frame and leaves it unpinned.
+   With a ring the frame is the one of the ring's oldest page if it can be recycled, and the page
+   joins the ring. Resident pages, pages still being written back, pages past the end of the file,
+   and files detached since the request was queued, are left alone. The file's size is checked
+   before any frame is given up, without the pool latch, on a copy of its name. */
+{
+    int part = partitionOf(bufferMgr, fileId, pageNum);
+    SM_FileHandle fileHandle;
+
+    latch(bufferMgr, &bufferMgr->poolLatch);
+    char *name = (bufferMgr->files[fileId].name != NULL) ? strdup(bufferMgr->files[fileId].name) : NULL;
+    unlatch(bufferMgr, &bufferMgr->poolLatch);
+    if (name == NULL || openPageFile(name, &fileHandle) != RC_OK) {
+        free(name);
+        return;
+    }
+    bool pastEnd = pageNum >= fileHandle.totalNumPages;
+    closePageFile(&fileHandle);
+    free(name);
+    if (pastEnd) return;
+
+    latch(bufferMgr, &bufferMgr->poolLatch);
+    if (bufferMgr->files[fileId].name == NULL) {
+        unlatch(bufferMgr, &bufferMgr->poolLatch);
+        return;
+    }
+    latch(bufferMgr, &bufferMgr->partLatch[part]);
+    bool resident = lookupFrame(bufferMgr, fileId, pageNum) != NULL;
+    unlatch(bufferMgr, &bufferMgr->partLatch[part]);
+
+    bool skip = resident || writeBackPending(bufferMgr, fileId, pageNum);
+    Frame *victim = (!skip && ring != NULL) ? selectRingVictim(bufferMgr, ring) : NULL;
+    if (!skip && victim == NULL) {
+        victim = selectVictim(bufferMgr);
+    }
+    if (victim == NULL) {
+        unlatch(bufferMgr, &bufferMgr->poolLatch);
+        return;  // Already cached or on its way to disk, or every frame is pinned
+    }
+
+    if (pinThispage(bufferMgr, victim, fileId, pageNum, true) == RC_OK && ring != NULL) {
+        addToRing(ring, fileId, pageNum);
+    }
+}
+
+static void *prefetcherMain(void *arg)
+/* Thread body: drains the prefetch queue until asked to stop. */
+{
+    Buffer *bufferMgr = arg;
+
+    pthread_mutex_lock(&bufferMgr->prefetch.latch);
+    while (!bufferMgr->prefetch.stop) {
+        if (bufferMgr->prefetch.count == 0) {
+            pthread_cond_wait(&bufferMgr->prefetch.ready, &bufferMgr->prefetch.latch);
+            continue;
+        }
+        PageKey request = bufferMgr->prefetch.queue[bufferMgr->prefetch.head];
+        bufferMgr->prefetch.head = (bufferMgr->prefetch.head + 1) % bufferMgr->prefetch.capacity;
+        bufferMgr->prefetch.count--;
+
+        pthread_mutex_unlock(&bufferMgr->prefetch.latch);
+        prefetchOne(bufferMgr, request.fileId, request.pageNum, NULL);
+        pthread_mutex_lock(&bufferMgr->prefetch.latch);
+    }
+    pthread_mutex_unlock(&bufferMgr->prefetch.latch);
+
+    return NULL;
+}
+
+static void stopPrefetcher(Buffer *bufferMgr)
+/* Stops and joins the prefetch thread if it is running; queued pages are dropped. */
+{
+    if (!bufferMgr->prefetch.on) return;
+
+    pthread_mutex_lock(&bufferMgr->prefetch.latch);
+    bufferMgr->prefetch.stop = true;
+    pthread_cond_signal(&bufferMgr->prefetch.ready);
+    pthread_mutex_unlock(&bufferMgr->prefetch.latch);
+    pthread_join(bufferMgr->prefetch.thread, NULL);
+    bufferMgr->prefetch.on = false;
+}
+
+static void dropPrefetches(Buffer *bufferMgr, int fileId)
+/* Removes the file's pages from the prefetch queue, keeping the order of the rest. */
+{
+    if (!bufferMgr->prefetch.on) return;
+
+    pthread_mutex_lock(&bufferMgr->prefetch.latch);
+    int kept = 0;
+    for (int i = 0; i < bufferMgr->prefetch.count; i++) {
+        PageKey request = bufferMgr->prefetch.queue[(bufferMgr->prefetch.head + i) % bufferMgr->prefetch.capacity];
+        if (request.fileId != fileId) {
+            bufferMgr->prefetch.queue[(bufferMgr->prefetch.head + kept) % bufferMgr->prefetch.capacity] = request;
+            kept++;
+        }
+    }
+    bufferMgr->prefetch.count = kept;
+    pthread_mutex_unlock(&bufferMgr->prefetch.latch);
+}
+
+RC prefetchPages(BM_BufferPool *const bm, const PageNumber *pageNums, int n)
+/* Asks for pages to be brought into the pool without pinning them.
+   With asyncPrefetch the pages are queued for the prefetch thread and the call returns at once
+   (pages that do not fit in the queue are dropped); otherwise they are read before returning.
+   Pages past the end of the file are ignored. */
+{
+    Buffer *bufferMgr = bufferOf(bm);
+    if (bufferMgr == NULL || (n > 0 && pageNums == NULL)) return RC_FILE_HANDLE_NOT_INIT;
+    int fileId = fileOf(bm);
+
+    if (!bufferMgr->prefetch.on) {
+        for (int i = 0; i < n; i++) {
+            if (pageNums[i] >= 0) prefetchOne(bufferMgr, fileId, pageNums[i], NULL);
+        }
+        return RC_OK;
+    }
+
+    pthread_mutex_lock(&bufferMgr->prefetch.latch);
+    for (int i = 0; i < n && bufferMgr->prefetch.count < bufferMgr->prefetch.capacity; i++) {
+        if (pageNums[i] < 0) continue;
+        int tail = (bufferMgr->prefetch.head + bufferMgr->prefetch.count) % bufferMgr->prefetch.capacity;
+        bufferMgr->prefetch.queue[tail].fileId = fileId;
+        bufferMgr->prefetch.queue[tail].pageNum = pageNums[i];
+        bufferMgr->prefetch.count++;
+    }
+    pthread_cond_signal(&bufferMgr->prefetch.ready);
+    pthread_mutex_unlock(&bufferMgr->prefetch.latch);
+
+    return RC_OK;
+}
+
+RC prefetchPagesWithRing(BM_BufferPool *const bm, const PageNumber *pageNums, int n, BM_AccessRing *ring)
+/* prefetchPages for a caller that pins through a ring: the pages are read into frames the ring
+   recycles, as its misses are, and join the ring, so reading ahead does not evict the rest of
+   the pool either. The ring belongs to the caller's thread, so the pages are read on it before
+   returning, with or without asyncPrefetch. A NULL ring prefetches as prefetchPages does. */
+{
+    Buffer *bufferMgr = bufferOf(bm);
+    if (ring == NULL) return prefetchPages(bm, pageNums, n);
+    if (bufferMgr == NULL || (n > 0 && pageNums == NULL)) return RC_FILE_HANDLE_NOT_INIT;
+
+    for (int i = 0; i < n; i++) {
+        if (pageNums[i] >= 0) prefetchOne(bufferMgr, fileOf(bm), pageNums[i], ring);
+    }
+    return RC_OK;
+}
+
+/* Access Rings */
+BM_AccessRing *createAccessRing(int numFrames)
+/* Allocates an empty ring of numFrames pages for one scan, bulk load or index build. */
+{
+    if (numFrames <= 0) return NULL;
+
+    BM_AccessRing *ring = malloc(sizeof(BM_AccessRing));
+    if (ring == NULL) return NULL;
+    ring->slots = malloc(sizeof(PageKey) * numFrames);
+    if (ring->slots == NULL) {
+        free(ring);
+        return NULL;
+    }
+    ring->size = numFrames;
+    ring->next = 0;
+    for (int i = 0; i < numFrames; i++) {
+        ring->slots[i].fileId = -1;
+        ring->slots[i].pageNum = NO_PAGE;
+    }
+    return ring;
+}
+
+void freeAccessRing(BM_AccessRing *ring)
+/* Frees the ring. Its pages stay cached until evicted. */
+{
+    if (ring == NULL) return;
+    free(ring->slots);
+    free(ring);
+}
+
+/* Synchronized Scans */
+BM_SyncScan *startSyncScan(BM_BufferPool *const bm, const PageNumber firstPage, const PageNumber endPage)
+/* Starts a scan of the handle's file from firstPage up to endPage (exclusive). If other scans of
+   the file are running, it joins them at the page they last reached and wraps around at endPage,
+   so all of them ask for the same pages at about the same time and each page is read once. */
+{
+    Buffer *bufferMgr = bufferOf(bm);
+    if (bufferMgr == NULL || firstPage < 0 || endPage < firstPage) return NULL;
+
+    BM_SyncScan *scan = malloc(sizeof(BM_SyncScan));
+    if (scan == NULL) return NULL;
+    scan->buffer = bufferMgr;
+    scan->fileId = fileOf(bm);
+    scan->firstPage = firstPage;
+    scan->endPage = endPage;
+    scan->nextPage = firstPage;
+    scan->remaining = endPage - firstPage;
+
+    PoolFile *file = &bufferMgr->files[scan->fileId];
+    latch(bufferMgr, &bufferMgr->poolLatch);
+    PageNumber position = atomic_load(&file->scanPosition);
+    if (file->numScans > 0 && position >= firstPage && position < endPage) {
+        scan->nextPage = position;  // The others still have this page pinned or cached
+    }
+    file->numScans++;
+    unlatch(bufferMgr, &bufferMgr->poolLatch);
+    return scan;
+}
+
+PageNumber nextSyncScanPage(BM_SyncScan *scan)
+/* Returns the scan's next page and reports it as the file's scan position, or NO_PAGE once
+   every page of the range has been returned. */
+{
+    if (scan == NULL || scan->remaining == 0) return NO_PAGE;
+
+    PageNumber pageNum = scan->nextPage;
+    scan->remaining--;
+    scan->nextPage = (pageNum + 1 == scan->endPage) ? scan->firstPage : pageNum + 1;
+    atomic_store(&scan->buffer->files[scan->fileId].scanPosition, pageNum);
+    return pageNum;
+}
+
+int peekSyncScanPages(const BM_SyncScan *scan, PageNumber *pageNums, int n)
+/* Fills pageNums with up to n pages the scan returns next, in the order nextSyncScanPage returns
+   them (wrapping around at endPage), without advancing it. Returns how many were filled. */
+{
+    if (scan == NULL || pageNums == NULL) return 0;
+
+    int count = (n < scan->remaining) ? n : scan->remaining;
+    PageNumber pageNum = scan->nextPage;
+    for (int i = 0; i < count; i++) {
+        pageNums[i] = pageNum;
+        pageNum = (pageNum + 1 == scan->endPage) ? scan->firstPage : pageNum + 1;
+    }
+    return count;
+}
+
+void endSyncScan(BM_SyncScan *scan)
+/* Leaves the file's group of scans and frees the scan. The last one out forgets the position. */
+{
+    if (scan == NULL) return;
+
+    Buffer *bufferMgr = scan->buffer;
+    PoolFile *file = &bufferMgr->files[scan->fileId];
+    latch(bufferMgr, &bufferMgr->poolLatch);
+    if (--file->numScans == 0) atomic_store(&file->scanPosition, NO_PAGE);
+    unlatch(bufferMgr, &bufferMgr->poolLatch);
+    free(scan);
+}
+
+/* Pin Tracing */
+static void flushTrace(Buffer *bufferMgr)
+/* Appends the collected records to the trace file. Caller holds the trace latch. */
+{
+    if (bufferMgr->trace.count > 0) {
+        fwrite(bufferMgr->trace.records, sizeof(BM_TraceRecord), bufferMgr->trace.count, bufferMgr->trace.file);
+        bufferMgr->trace.count = 0;
+    }
+}
+
+static void tracePin(Buffer *bufferMgr, int fileId, PageNumber pageNum)
+/* Records a pin request in the pool's trace, if one is running. */
+{
+    if (!atomic_load(&bufferMgr->trace.active)) return;
+
+    pthread_mutex_lock(&bufferMgr->trace.latch);
+    if (bufferMgr->trace.file != NULL) {
+        struct timespec now;
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        long long micros = (now.tv_sec - bufferMgr->trace.last.tv_sec) * 1000000LL
+                           + (now.tv_nsec - bufferMgr->trace.last.tv_nsec) / 1000;
+        bufferMgr->trace.last = now;
+
+        BM_TraceRecord *record = &bufferMgr->trace.records[bufferMgr->trace.count++];
+        record->fileId = fileId;
+        record->pageNum = pageNum;
+        record->deltaMicros = (micros > 0xFFFFFFFFLL) ? 0xFFFFFFFFu : (unsigned int)micros;
+        if (bufferMgr->trace.count == TRACE_BUFFER_RECORDS) {
+            flushTrace(bufferMgr);
+        }
+    }
+    pthread_mutex_unlock(&bufferMgr->trace.latch);
+}
+
+static RC closeTrace(Buffer *bufferMgr)
+/* Writes the remaining records and closes the trace. */
+{
+    RC resultCode = RC_FILE_HANDLE_NOT_INIT;  // Not tracing
+
+    pthread_mutex_lock(&bufferMgr->trace.latch);
+    if (bufferMgr->trace.file != NULL) {
+        flushTrace(bufferMgr);
+        resultCode = (fclose(bufferMgr->trace.file) == 0) ? RC_OK : RC_WRITE_FAILED;
+        bufferMgr->trace.file = NULL;
+        free(bufferMgr->trace.records);
+        bufferMgr->trace.records = NULL;
+        atomic_store(&bufferMgr->trace.active, 0);
+    }
+    pthread_mutex_unlock(&bufferMgr->trace.latch);
+
+    return resultCode;
+}
+
+RC startPinTrace(BM_BufferPool *const bm, const char *const traceFileName)
+/* Starts recording every page pin of the handle's pool, for all its files, to traceFileName.
+   A trace that is already running is finished first. */
+{
+    Buffer *bufferMgr = bufferOf(bm);
+    if (bufferMgr == NULL) return RC_FILE_HANDLE_NOT_INIT;
+
+    closeTrace(bufferMgr);
+
+    FILE *traceFile = fopen(traceFileName, "wb");
+    BM_TraceRecord *traceBuffer = malloc(sizeof(BM_TraceRecord) * TRACE_BUFFER_RECORDS);
+    BM_TraceHeader header = {PIN_TRACE_MAGIC, PIN_TRACE_VERSION, sizeof(BM_TraceRecord)};
+    if (traceFile == NULL || traceBuffer == NULL || fwrite(&header, sizeof(header), 1, traceFile) != 1) {
+        if (traceFile != NULL) fclose(traceFile);
+        free(traceBuffer);
+        return (traceFile == NULL) ? RC_FILE_NOT_FOUND : RC_WRITE_FAILED;
+    }
+
+    pthread_mutex_lock(&bufferMgr->trace.latch);
+    bufferMgr->trace.file = traceFile;
+    bufferMgr->trace.records = traceBuffer;
+    bufferMgr->trace.count = 0;
+    clock_gettime(CLOCK_MONOTONIC, &bufferMgr->trace.last);
+    atomic_store(&bufferMgr->trace.active, 1);
+    pthread_mutex_unlock(&bufferMgr->trace.latch);
+
+    return RC_OK;
+}
+
+RC stopPinTrace(BM_BufferPool *const bm)
+/* Finishes the pool's trace. Returns RC_FILE_HANDLE_NOT_INIT if none is running. */
+{
+    Buffer *bufferMgr = bufferOf(bm);
+    if (bufferMgr == NULL) return RC_FILE_HANDLE_NOT_INIT;
+
+    return closeTrace(bufferMgr);
+}
+
+/* Adaptive strategy */
+static void freeShadows(Buffer *bufferMgr)
+/* Frees the shadow caches. */
+{
+    for (int i = 0; i < NUM_SHADOWS; i++) {
+        free(bufferMgr->adapt.shadows[i].keys);
+        free(bufferMgr->adapt.shadows[i].meta);
+        bufferMgr->adapt.shadows[i].keys = NULL;
+        bufferMgr->adapt.shadows[i].meta = NULL;
+    }
+}
+
+static bool buildShadows(Buffer *bufferMgr)
+/* (Re)creates empty shadow caches for the pool's current size and starts a new window.
+   Pages are sampled by hash so each shadow sees every pin of its pages, as the pool would;
+   a pool of f frames samples one page in ceil(f / ADAPT_SHADOW_FRAMES) into shadows of
+   f / that many frames. Caller holds the adapt latch, or is creating the pool. */
+{
+    static const ReplacementStrategy shadowed[NUM_SHADOWS] = {RS_FIFO, RS_LRU, RS_CLOCK, RS_GCLOCK};
+
+    freeShadows(bufferMgr);
+    bufferMgr->adapt.rate = (bufferMgr->numFrames + ADAPT_SHADOW_FRAMES - 1) / ADAPT_SHADOW_FRAMES;
+    bufferMgr->adapt.shadowFrames = bufferMgr->numFrames / bufferMgr->adapt.rate;
+    bufferMgr->adapt.shadowClock = 0;
+    bufferMgr->adapt.windowPins = 0;
+
+    bool built = true;
+    for (int i = 0; i < NUM_SHADOWS; i++) {
+        ShadowCache *shadow = &bufferMgr->adapt.shadows[i];
+        shadow->strategy = shadowed[i];
+        shadow->keys = malloc(sizeof(PageKey) * bufferMgr->adapt.shadowFrames);
+        shadow->meta = calloc(bufferMgr->adapt.shadowFrames, sizeof(unsigned int));
+        shadow->hand = 0;
+        shadow->hits = 0;
+        if (shadow->keys == NULL || shadow->meta == NULL) {
+            built = false;
+            continue;
+        }
+        for (int f = 0; f < bufferMgr->adapt.shadowFrames; f++) shadow->keys[f].fileId = -1;
+    }
+    if (!built) freeShadows(bufferMgr);
+    return built;
+}
+
+static bool shadowAccess(ShadowCache *shadow, int numFrames, unsigned int stamp, PageKey key)
+/* Replays one sampled pin on a shadow cache the way the strategy treats the pool's frames.
+   Returns whether the page was in the shadow. */
+{
+    int maxUsage = maxUsageOf(shadow->strategy);
+
+    for (int f = 0; f < numFrames; f++) {
+        if (shadow->keys[f].pageNum == key.pageNum && shadow->keys[f].fileId == key.fileId) {
+            if (shadow->strategy == RS_LRU) {
+                shadow->meta[f] = stamp;
+            } else if (shadow->meta[f] < (unsigned int)maxUsage) {
+                shadow->meta[f]++;
+            }
+            return true;
+        }
+    }
+
+    int slot = 0;
+    if (shadow->strategy == RS_LRU) {
+        // Least recently used; empty slots carry stamp 0 and go first
+        for (int f = 1; f < numFrames; f++) {
+            if (shadow->meta[f] < shadow->meta[slot]) slot = f;
+        }
+    } else if (shadow->strategy == RS_FIFO) {
+        slot = shadow->hand;
+        shadow->hand = (shadow->hand + 1) % numFrames;
+    } else {
+        // Sweep from the frame after the hand, counting usage down, as selectVictimCLOCK does
+        for (;;) {
+            shadow->hand = (shadow->hand + 1) % numFrames;
+            if (shadow->keys[shadow->hand].fileId < 0 || shadow->meta[shadow->hand] == 0) break;
+            shadow->meta[shadow->hand]--;
+        }
+        slot = shadow->hand;
+    }
+    shadow->keys[slot] = key;
+    shadow->meta[slot] = (shadow->strategy == RS_LRU) ? stamp : 0;
+    return false;
+}
+
+static void switchStrategy(Buffer *bufferMgr, ReplacementStrategy strategy)
+/* Changes the live strategy. FIFO, LRU, CLOCK and GCLOCK share the frame list and the clock hand,
+   so the frames keep their pages; the new strategy orders them from its next hit or load on. */
+{
+    latch(bufferMgr, &bufferMgr->poolLatch);
+    if (bufferMgr->strategy != strategy) {
+        bufferMgr->strategy = strategy;
+        atomic_store(&bufferMgr->maxUsage, maxUsageOf(strategy));
+        atomic_fetch_add(&bufferMgr->adapt.numSwitches, 1);
+    }
+    unlatch(bufferMgr, &bufferMgr->poolLatch);
+}
+
+static void adaptSample(Buffer *bufferMgr, int fileId, PageNumber pageNum)
+/* Feeds a pin of a sampled page to every shadow cache. After adapt.window sampled pins, switches
+   the pool to the shadow with the most hits if it beat the live strategy's shadow by at least
+   ADAPT_MIN_GAIN of the window, then starts a new window. */
+{
+    if (!bufferMgr->adapt.enabled || pageNum < 0) return;
+    if ((hashOf(fileId, pageNum) >> 8) % (unsigned int)bufferMgr->adapt.rate != 0) return;
+
+    PageKey key = {fileId, pageNum};
+    ReplacementStrategy best = bufferMgr->strategy;
+
+    latch(bufferMgr, &bufferMgr->adapt.latch);
+    if (bufferMgr->adapt.shadows[0].keys == NULL) {
+        unlatch(bufferMgr, &bufferMgr->adapt.latch);
+        return;  // A resize could not rebuild the shadows; stay with the live strategy
+    }
+    unsigned int stamp = ++bufferMgr->adapt.shadowClock;
+    for (int i = 0; i < NUM_SHADOWS; i++) {
+        if (shadowAccess(&bufferMgr->adapt.shadows[i], bufferMgr->adapt.shadowFrames, stamp, key)) {
+            bufferMgr->adapt.shadows[i].hits++;
+        }
+    }
+
+    if (++bufferMgr->adapt.windowPins >= bufferMgr->adapt.window) {
+        long liveHits = 0, bestHits = -1;
+        for (int i = 0; i < NUM_SHADOWS; i++) {
+            if (bufferMgr->adapt.shadows[i].strategy == bufferMgr->strategy) liveHits = bufferMgr->adapt.shadows[i].hits;
+            if (bufferMgr->adapt.shadows[i].hits > bestHits) {
+                bestHits = bufferMgr->adapt.shadows[i].hits;
+                best = bufferMgr->adapt.shadows[i].strategy;
+            }
+            bufferMgr->adapt.shadows[i].hits = 0;
+        }
+        if (bestHits - liveHits < ADAPT_MIN_GAIN * bufferMgr->adapt.windowPins) {
+            best = bufferMgr->strategy;  // Not clearly better; switching would only churn
+        }
+        bufferMgr->adapt.windowPins = 0;
+    }
+    unlatch(bufferMgr, &bufferMgr->adapt.latch);
+
+    if (best != bufferMgr->strategy) switchStrategy(bufferMgr, best);
+}
+
+RC pinLRUK (BM_BufferPool *const bm, BM_PageHandle *const page,
+            const PageNumber pageNum)
+{
+
+    return RC_OK;
+}
+
+/* Frame Arena */
+static char *mapChunk(Buffer *bufferMgr, size_t bytes, bool *huge)
+/* Maps bytes of zeroed memory for frame data. Chunks of whole huge pages are 2 MB-aligned and
+   advised for transparent huge pages, after trying MAP_HUGETLB if asked to; anything that is not
+   available falls back to ordinary pages. */
+{
+    char *base;
+
+    *huge = false;
+    if (!bufferMgr->arena.hugePages || bytes % HUGE_PAGE_BYTES != 0) {
+        base = mmap(NULL, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        return (base == MAP_FAILED) ? NULL : base;
+    }
+
+#ifdef MAP_HUGETLB
+    if (bufferMgr->arena.hugeTlb) {
+        base = mmap(NULL, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (base != MAP_FAILED) {
+            *huge = true;
+            return base;
+        }
+    }
+#endif
+
+    // Over-allocate by one huge page and trim both ends to get the alignment
+    char *raw = mmap(NULL, bytes + HUGE_PAGE_BYTES, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (raw == MAP_FAILED) return NULL;
+    base = (char *)(((uintptr_t)raw + HUGE_PAGE_BYTES - 1) & ~(uintptr_t)(HUGE_PAGE_BYTES - 1));
+    if (base > raw) munmap(raw, base - raw);
+    munmap(base + bytes, raw + HUGE_PAGE_BYTES - base);
+
+#ifdef MADV_HUGEPAGE
+    *huge = (madvise(base, bytes, MADV_HUGEPAGE) == 0);  // Fails without THP support; plain pages then
+#endif
+    return base;
+}
+
+static bool growArena(Buffer *bufferMgr, int numSlots)
+/* Maps room for at least numSlots more frames and adds the slots to the free list. With huge
+   pages the chunk is rounded up to whole huge pages once it spans one, and the extra slots are
+   kept for later growth. */
+{
+    size_t bytes = (size_t)numSlots * PAGE_SIZE;
+    bool huge;
+
+    if (bufferMgr->arena.hugePages && bytes >= HUGE_PAGE_BYTES) {
+        bytes = (bytes + HUGE_PAGE_BYTES - 1) / HUGE_PAGE_BYTES * HUGE_PAGE_BYTES;
+    }
+    ArenaChunk *chunk = malloc(sizeof(ArenaChunk));
+    if (chunk == NULL) return false;
+    chunk->base = mapChunk(bufferMgr, bytes, &huge);
+    if (chunk->base == NULL) {
+        free(chunk);
+        return false;
+    }
+    chunk->bytes = bytes;
+    chunk->next = bufferMgr->arena.chunks;
+    bufferMgr->arena.chunks = chunk;
+    bufferMgr->arena.bytes += bytes;
+    if (huge) bufferMgr->arena.hugePageBytes += bytes;
+
+    // Pushed from the end, so frames are handed out in address order
+    for (size_t offset = bytes; offset >= PAGE_SIZE; offset -= PAGE_SIZE) {
+        char *slot = chunk->base + offset - PAGE_SIZE;
+        *(char **)slot = bufferMgr->arena.freeSlots;
+        bufferMgr->arena.freeSlots = slot;
+        bufferMgr->arena.numFreeSlots++;
+    }
+    return true;
+}
+
+static void releaseSlot(Buffer *bufferMgr, char *slot)
+/* Puts a frame's data slot back on the free list. */
+{
+    *(char **)slot = bufferMgr->arena.freeSlots;
+    bufferMgr->arena.freeSlots = slot;
+    bufferMgr->arena.numFreeSlots++;
+}
+
+static void freeFrame(Buffer *bufferMgr, Frame *frame)
+/* Returns the frame's slot to the arena and frees it. */
+{
+    releaseSlot(bufferMgr, frame->data);
+    pthread_rwlock_destroy(&frame->pageLatch);
+    free(frame);
+}
+
+static void unmapArena(Buffer *bufferMgr)
+/* Unmaps every arena chunk. */
+{
+    while (bufferMgr->arena.chunks != NULL) {
+        ArenaChunk *next = bufferMgr->arena.chunks->next;
+        munmap(bufferMgr->arena.chunks->base, bufferMgr->arena.chunks->bytes);
+        free(bufferMgr->arena.chunks);
+        bufferMgr->arena.chunks = next;
+    }
+    bufferMgr->arena.freeSlots = NULL;
+    bufferMgr->arena.numFreeSlots = 0;
+}
+
+/* Pool Lifecycle */
+static void registerPool(Buffer *bufferMgr)
+/* Adds a new pool to the memory governor's list. */
+{
+    pthread_mutex_lock(&governorLatch);
+    bufferMgr->governor.next = governedPools;
+    governedPools = bufferMgr;
+    pthread_mutex_unlock(&governorLatch);
+}
+
+static void unregisterPool(Buffer *bufferMgr)
+/* Takes a pool about to be freed off the memory governor's list. */
+{
+    pthread_mutex_lock(&governorLatch);
+    Buffer **link = &governedPools;
+    while (*link != NULL && *link != bufferMgr) link = &(*link)->governor.next;
+    if (*link != NULL) *link = bufferMgr->governor.next;
+    pthread_mutex_unlock(&governorLatch);
+}
+
+static Frame *newFrame(Buffer *bufferMgr)
+/* Allocates an empty, unpinned frame on a free arena slot; see growArena. */
+{
+    if (bufferMgr->arena.freeSlots == NULL) return NULL;
+    Frame *frame = malloc(sizeof(Frame));
+    if (frame == NULL) return NULL;
+    frame->data = bufferMgr->arena.freeSlots;
+    bufferMgr->arena.freeSlots = *(char **)frame->data;
+    bufferMgr->arena.numFreeSlots--;
+
+    frame->currpage = NO_PAGE;
+    frame->fileId = 0;
+    frame->dirty = false;
+    atomic_init(&frame->usage, 0);
+    frame->ioInProgress = false;
+    frame->prefetched = false;
+    frame->dirtyIdx = -1;
+    frame->loadSeq = 0;
+    atomic_init(&frame->version, 0);
+    atomic_init(&frame->residency, 0);
+    frame->hashNext = NULL;
+    atomic_init(&frame->fixCount, 0);
+    pthread_rwlock_init(&frame->pageLatch, NULL);
+    memset(frame->data, '\0', PAGE_SIZE);
+    return frame;
+}
+
+static void initStats(PoolStatCounters *stats)
+/* Zeroes the pool's statistics. */
+{
+    atomic_init(&stats->numHits, 0);
+    atomic_init(&stats->numMisses, 0);
+    atomic_init(&stats->numPinWaits, 0);
+    atomic_init(&stats->numPinCacheHits, 0);
+    atomic_init(&stats->numSearches, 0);
+    atomic_init(&stats->numSearchSteps, 0);
+    for (int i = 0; i < BM_SEARCH_BUCKETS; i++) atomic_init(&stats->searchLength[i], 0);
+    for (int i = 0; i < BM_LATENCY_BUCKETS; i++) {
+        atomic_init(&stats->hitLatency[i], 0);
+        atomic_init(&stats->missLatency[i], 0);
+    }
+    atomic_init(&stats->numEvictions, 0);
+    atomic_init(&stats->numCleanEvictions, 0);
+    atomic_init(&stats->numOptimisticReads, 0);
+    atomic_init(&stats->numOptimisticFallbacks, 0);
+    atomic_init(&stats->numLatchWaits, 0);
+}
+
+static void initArena(FrameArena *arena, const BM_PoolOptions *options)
+/* An arena with nothing mapped yet; see growArena. */
+{
+    arena->chunks = NULL;
+    arena->freeSlots = NULL;
+    arena->numFreeSlots = 0;
+    arena->hugePages = options->hugePages;
+    arena->hugeTlb = options->hugeTlb;
+    arena->bytes = 0;
+    arena->hugePageBytes = 0;
+}
+
+static bool initDirtySet(DirtySet *dirtySet, int numPages)
+/* An empty dirty set with room for numPages frames. Returns false without memory for it. */
+{
+    dirtySet->frames = malloc(sizeof(Frame *) * numPages);
+    dirtySet->count = 0;
+    pthread_mutex_init(&dirtySet->latch, NULL);
+    return dirtySet->frames != NULL;
+}
+
+static void freeDirtySet(DirtySet *dirtySet)
+/* Frees the set; the frames are freed separately. */
+{
+    pthread_mutex_destroy(&dirtySet->latch);
+    free(dirtySet->frames);
+}
+
+static void initWriteBacks(WriteBacks *writeBacks)
+/* No victim write-backs in flight. */
+{
+    writeBacks->list = NULL;
+    pthread_mutex_init(&writeBacks->latch, NULL);
+    pthread_cond_init(&writeBacks->done, NULL);
+}
+
+static void freeWriteBacks(WriteBacks *writeBacks)
+/* Destroys the write-back latch; every write-back has finished. */
+{
+    pthread_mutex_destroy(&writeBacks->latch);
+    pthread_cond_destroy(&writeBacks->done);
+}
+
+static void initWriter(BackgroundWriter *writer, const BM_PoolOptions *options)
+/* Settings of the background writer; the thread is started once the frames exist. */
+{
+    writer->on = false;
+    writer->rounds = options->backgroundWriter;
+    writer->stop = false;
+    writer->delayMs = (options->bgWriterDelayMs > 0) ? options->bgWriterDelayMs : 1;
+    writer->maxPages = (options->bgWriterMaxPages > 0) ? options->bgWriterMaxPages : 1;
+    writer->lowWater = options->bgWriterLowWater;
+    writer->highWater = (options->bgWriterHighWater > options->bgWriterLowWater)
+                        ? options->bgWriterHighWater : options->bgWriterLowWater;
+    pthread_mutex_init(&writer->latch, NULL);
+    pthread_cond_init(&writer->wakeup, NULL);
+    atomic_init(&writer->numWrites, 0);
+}
+
+static void freeWriter(BackgroundWriter *writer)
+/* Caller has stopped the thread; see stopBackgroundWriter. */
+{
+    pthread_mutex_destroy(&writer->latch);
+    pthread_cond_destroy(&writer->wakeup);
+}
+
+static void initWriteBehind(WriteBehindQueue *wb, const BM_PoolOptions *options)
+/* An empty write-behind queue. Without memory for it the option is turned off, and dirty
+   victims are written by the miss as without it. */
+{
+    wb->enabled = options->writeBehind;
+    wb->capacity = (options->writeBehindPages > 0) ? options->writeBehindPages : 1;
+    wb->queued = NULL;
+    wb->numQueued = 0;
+    wb->writing = NULL;
+    wb->numWriting = 0;
+    wb->buffers = NULL;
+    pthread_mutex_init(&wb->latch, NULL);
+    pthread_cond_init(&wb->written, NULL);
+    atomic_init(&wb->numQueuedWrites, 0);
+    atomic_init(&wb->numQueueHits, 0);
+    if (!wb->enabled) return;
+
+    wb->queued = malloc(sizeof(QueuedWrite) * wb->capacity);
+    wb->writing = malloc(sizeof(QueuedWrite) * wb->capacity);
+    wb->buffers = malloc((size_t)2 * wb->capacity * PAGE_SIZE);
+    if (wb->queued != NULL && wb->writing != NULL && wb->buffers != NULL) {
+        for (int i = 0; i < wb->capacity; i++) {
+            wb->queued[i].data = wb->buffers + (size_t)i * PAGE_SIZE;
+            wb->writing[i].data = wb->buffers + (size_t)(wb->capacity + i) * PAGE_SIZE;
+        }
+    } else {
+        wb->enabled = false;
+    }
+}
+
+static void freeWriteBehind(WriteBehindQueue *wb)
+/* Frees the queue and its page buffers. */
+{
+    pthread_mutex_destroy(&wb->latch);
+    pthread_cond_destroy(&wb->written);
+    free(wb->queued);
+    free(wb->writing);
+    free(wb->buffers);
+}
+
+static void initPrefetcher(Prefetcher *prefetch, int numPages)
+/* Prefetch counters and an empty queue; the thread is started once the frames exist. */
+{
+    atomic_init(&prefetch->loadClock, 0);
+    atomic_init(&prefetch->numUnused, 0);
+    atomic_init(&prefetch->numPrefetches, 0);
+    atomic_init(&prefetch->numHits, 0);
+    atomic_init(&prefetch->numWasted, 0);
+    prefetch->on = false;
+    prefetch->stop = false;
+    prefetch->queue = NULL;
+    prefetch->capacity = numPages;
+    prefetch->head = 0;
+    prefetch->count = 0;
+    pthread_mutex_init(&prefetch->latch, NULL);
+    pthread_cond_init(&prefetch->ready, NULL);
+}
+
+static void freePrefetcher(Prefetcher *prefetch)
+/* Caller has stopped the thread; see stopPrefetcher. */
+{
+    pthread_mutex_destroy(&prefetch->latch);
+    pthread_cond_destroy(&prefetch->ready);
+    free(prefetch->queue);
+}
+
+static void initCompressedCache(CompressedCache *cc, const BM_PoolOptions *options)
+/* An empty compressed cache, turned off if it was not asked for or its table cannot be allocated. */
+{
+    cc->enabled = options->compressedCache;
+    cc->budget = (options->compressedCacheBytes > 0) ? options->compressedCacheBytes : 0;
+    cc->bytes = 0;
+    cc->numBuckets = 64;  // About one per entry if pages compress to a quarter
+    while (cc->numBuckets < cc->budget / (PAGE_SIZE / 4)) cc->numBuckets *= 2;
+    cc->table = cc->enabled ? calloc(cc->numBuckets, sizeof(CompressedPage *)) : NULL;
+    if (cc->table == NULL) cc->enabled = false;
+    cc->newest = NULL;
+    cc->oldest = NULL;
+    cc->stamp = 0;
+    pthread_mutex_init(&cc->latch, NULL);
+    atomic_init(&cc->numStores, 0);
+    atomic_init(&cc->numHits, 0);
+    atomic_init(&cc->numDrops, 0);
+}
+
+static void freeCompressedCache(CompressedCache *cc)
+/* Frees every entry and the table. */
+{
+    while (cc->oldest != NULL) {
+        CompressedPage *newer = cc->oldest->newer;
+        freeCompressed(cc->oldest);
+        cc->oldest = newer;
+    }
+    free(cc->table);
+    pthread_mutex_destroy(&cc->latch);
+}
+
+static void initScratch(ScratchSpace *scratch)
+/* No scratch pages; the temp file and the tables are created on first use. */
+{
+    scratch->file = NULL;
+    scratch->state = NULL;
+    scratch->freeList = NULL;
+    scratch->numFree = 0;
+    scratch->capacity = 0;
+    scratch->end = 0;
+    scratch->numPages = 0;
+    atomic_init(&scratch->numSpills, 0);
+}
+
+static void freeScratch(ScratchSpace *scratch)
+/* Closes the temp file and frees the scratch page tables. */
+{
+    if (scratch->file != NULL) fclose(scratch->file);  // Scratch pages are discarded with it
+    free(scratch->state);
+    free(scratch->freeList);
+}
+
+static void initGovernor(GovernorState *governor, int numPages)
+/* No ghosts yet; the pool is put on governedPools by registerPool. */
+{
+    for (int i = 0; i < GOVERNOR_STEP_PAGES; i++) governor->ghosts[i].pageNum = NO_PAGE;
+    governor->ghostNext = 0;
+    atomic_init(&governor->numGhostHits, 0);
+    governor->gainMark = 0;
+    governor->minFrames = (numPages < GOVERNOR_MIN_PAGES) ? numPages : GOVERNOR_MIN_PAGES;
+    governor->next = NULL;
+}
+
+static void initAdaptive(Buffer *bufferMgr, ReplacementStrategy strategy, const BM_PoolOptions *options)
+/* Builds the shadow caches if the adaptive mode was asked for. Needs numFrames. */
+{
+    AdaptiveState *adapt = &bufferMgr->adapt;
+
+    adapt->enabled = options->adaptiveStrategy
+                     && (strategy == RS_FIFO || strategy == RS_LRU || strategy == RS_CLOCK || strategy == RS_GCLOCK);
+    adapt->window = (options->adaptWindowPins > 0) ? options->adaptWindowPins : 1;
+    memset(adapt->shadows, 0, sizeof(adapt->shadows));
+    pthread_mutex_init(&adapt->latch, NULL);
+    atomic_init(&adapt->numSwitches, 0);
+    if (adapt->enabled && !buildShadows(bufferMgr)) {
+        adapt->enabled = false;  // No memory for the shadows; keep the strategy fixed
+    }
+}
+
+static void freeAdaptive(Buffer *bufferMgr)
+/* Frees the shadow caches and destroys the adapt latch. */
+{
+    freeShadows(bufferMgr);
+    pthread_mutex_destroy(&bufferMgr->adapt.latch);
+}
+
+static void initHotPages(HotPages *hot, const BM_PoolOptions *options)
+/* Warm restart settings from the options. */
+{
+    hot->save = options->saveHotPages;
+    hot->intervalMs = (options->saveHotPages && options->hotPagesIntervalMs > 0) ? options->hotPagesIntervalMs : 0;
+    hot->preload = options->preloadHotPages;
+}
+
+static void initTrace(PinTrace *trace)
+/* No trace open; see startPinTrace. */
+{
+    atomic_init(&trace->active, 0);
+    pthread_mutex_init(&trace->latch, NULL);
+    trace->file = NULL;
+    trace->records = NULL;
+    trace->count = 0;
+}
+
+static void freeTrace(Buffer *bufferMgr)
+/* Closes a trace still open and destroys the trace latch. */
+{
+    closeTrace(bufferMgr);
+    pthread_mutex_destroy(&bufferMgr->trace.latch);
+}
+
+static void freeBuffer(Buffer *bufferMgr)
+/* Frees the frames, the file names, the latches and every group of a pool whose threads are
+   stopped. The frame list may be one createBuffer gave up on: NULL-ended, or empty. */
+{
+    Frame *currentFrame = bufferMgr->head;
+
+    // Deallocate all frames in the list, up to and including the tail
+    while (currentFrame != NULL) {
+        Frame *nextFrame = (currentFrame == bufferMgr->tail) ? NULL : currentFrame->next;
+        pthread_rwlock_destroy(&currentFrame->pageLatch);
+        free(currentFrame);
+        currentFrame = nextFrame;
+    }
+
+    statlist *currentStat = bufferMgr->stathead;
+    while (currentStat != NULL) {
+        statlist *nextStat = currentStat->next;
+        free(currentStat);
+        currentStat = nextStat;
+    }
+
+    for (int f = 0; f < MAX_POOL_FILES; f++) {
+        free(bufferMgr->files[f].name);
+    }
+    pthread_mutex_destroy(&bufferMgr->flushLatch);
+    pthread_mutex_destroy(&bufferMgr->resizeLatch);
+    pthread_mutex_destroy(&bufferMgr->extendLatch);
+    pthread_mutex_destroy(&bufferMgr->poolLatch);
+    for (int p = 0; p < NUM_LATCH_PARTITIONS; p++) {
+        pthread_mutex_destroy(&bufferMgr->partLatch[p]);
+        pthread_cond_destroy(&bufferMgr->ioDone[p]);
+    }
+    freeTrace(bufferMgr);
+    freeAdaptive(bufferMgr);
+    freeScratch(&bufferMgr->scratch);
+    freeCompressedCache(&bufferMgr->cc);
+    freePrefetcher(&bufferMgr->prefetch);
+    freeWriteBehind(&bufferMgr->wb);
+    freeWriter(&bufferMgr->writer);
+    freeWriteBacks(&bufferMgr->writeBacks);
+    freeDirtySet(&bufferMgr->dirtySet);
+    free(bufferMgr->pageTable);
+    while (bufferMgr->retired != NULL) {
+        Retired *next = bufferMgr->retired->next;
+        free(bufferMgr->retired->block);
+        free(bufferMgr->retired);
+        bufferMgr->retired = next;
+    }
+    unmapArena(bufferMgr);
+    free(bufferMgr);        // Free the buffer manager
+}
+
+static RC createBuffer(Buffer **result, const int numPages, ReplacementStrategy strategy,
+                       void *stratData, const BM_PoolOptions *const opts)
+//create page frames using circular list and the page table; no file is attached yet
+{
+    BM_PoolOptions defaults;
+    if (opts == NULL) {
+        initPoolOptions(&defaults);
+    }
+    const BM_PoolOptions *options = (opts != NULL) ? opts : &defaults;
+
+    //error check
+    if (numPages<=0) //input check
+        return RC_WRITE_FAILED;
+    //init bf:bookkeeping data
+    Buffer *bf = malloc(sizeof(Buffer));
+
+    if (bf==NULL) return RC_MEMORY_ALLOCATION_FAIL;
+    bf->numFrames = numPages;
+    bf->stratData = stratData;
+    bf->strategy = strategy;
+    atomic_init(&bf->maxUsage, maxUsageOf(strategy));
+    memset(bf->files, 0, sizeof(bf->files));
+    bf->numViews = 0;
+    bf->keepAlive = false;
+    atomic_init(&bf->numRead, 0);
+    atomic_init(&bf->numWrite, 0);
+    bf->threadSafe = options->threadSafe || options->backgroundWriter  // these run a second thread
+                     || options->asyncPrefetch || (options->saveHotPages && options->hotPagesIntervalMs > 0)
+                     || options->writeBehind;
+    bf->poolSerial = atomic_fetch_add(&lastPoolSerial, 1) + 1;
+    bf->pinCache = options->pinCache;
+    bf->head = NULL;
+    bf->tail = NULL;
+    bf->stathead = NULL;
+    initStats(&bf->stats);
+
+    //page table: at least twice as many buckets as frames keeps chains short
+    int numBuckets = NUM_LATCH_PARTITIONS;
+    while (numBuckets < 2 * numPages) numBuckets *= 2;
+    atomic_init(&bf->numBuckets, numBuckets);
+    bf->pageTable = calloc(numBuckets, sizeof(FrameLink));
+    bf->retired = NULL;
+    pthread_mutex_init(&bf->flushLatch, NULL);
+    pthread_mutex_init(&bf->resizeLatch, NULL);
+    pthread_mutex_init(&bf->extendLatch, NULL);
+    pthread_mutex_init(&bf->poolLatch, NULL);
+    for (int p = 0; p < NUM_LATCH_PARTITIONS; p++) {
+        pthread_mutex_init(&bf->partLatch[p], NULL);
+        pthread_cond_init(&bf->ioDone[p], NULL);
+    }
+    initArena(&bf->arena, options);
+    bool dirtySetBuilt = initDirtySet(&bf->dirtySet, numPages);
+    initWriteBacks(&bf->writeBacks);
+    initWriter(&bf->writer, options);
+    initWriteBehind(&bf->wb, options);
+    initPrefetcher(&bf->prefetch, numPages);
+    initCompressedCache(&bf->cc, options);
+    initScratch(&bf->scratch);
+    initGovernor(&bf->governor, numPages);
+    initAdaptive(bf, strategy, options);
+    initHotPages(&bf->hot, options);
+    initTrace(&bf->trace);
+    if (bf->pageTable==NULL || !dirtySetBuilt || !growArena(bf, numPages)) {
+        freeBuffer(bf);
+        return RC_MEMORY_ALLOCATION_FAIL;
+    }
+
+    //create list
+    Frame *phead = NULL;
+    statlist *shead = NULL;
+
+    for (int i=0; i<numPages; i++) {
+        Frame *pnew = newFrame(bf);
+        statlist *snew = malloc(sizeof(statlist));
+        if (pnew==NULL || snew==NULL) {
+            if (pnew != NULL) freeFrame(bf, pnew);
+            free(snew);
+            freeBuffer(bf);  // The frames built so far end at tail
+            return RC_MEMORY_ALLOCATION_FAIL;
+        }
+
+        snew->fpt = pnew;
+        snew->next = NULL;
+        if (shead == NULL) bf->stathead = snew; else shead->next = snew;
+        shead = snew;
+
+        if (phead == NULL) bf->head = pnew; else phead->next = pnew;
+        pnew->prev = phead;
+        phead = pnew;
+        bf->tail = phead;
+    }
+    bf->pointer = bf->head;
+
+    //circular list for clock
+    bf->tail->next = bf->head;
+    bf->head->prev = bf->tail;
+
+    if (options->asyncPrefetch) {
+        bf->prefetch.queue = malloc(sizeof(PageKey) * numPages);
+        if (bf->prefetch.queue != NULL && pthread_create(&bf->prefetch.thread, NULL, prefetcherMain, bf) == 0) {
+            bf->prefetch.on = true;
+        }
+    }
+    if (options->backgroundWriter || bf->hot.intervalMs > 0 || bf->wb.enabled) {
+        if (pthread_create(&bf->writer.thread, NULL, backgroundWriterMain, bf) == 0) {
+            bf->writer.on = true;
+        }
+    }
+
+    registerPool(bf);
+    *result = bf;
+    return RC_OK;
+}
+
+static RC destroyBuffer(Buffer *bufferMgr)
+/* Stops the pool's threads and frees it. Every view has been detached, so nothing is dirty, and
+   nothing is queued for write-behind since detaching a file waits until none of its pages are.
+   Pages still queued anyway have lost their file; they are dropped and RC_WRITE_FAILED reports it. */
+{
+    unregisterPool(bufferMgr);
+    stopPrefetcher(bufferMgr);
+    stopBackgroundWriter(bufferMgr);
+    RC resultCode = (bufferMgr->wb.numQueued + bufferMgr->wb.numWriting > 0) ? RC_WRITE_FAILED : RC_OK;
+    freeBuffer(bufferMgr);
+    return resultCode;
+}
+
+static RC attachView(BM_BufferPool *const bm, Buffer *bufferMgr, const char *const pageFileName)
+/* Points bm at the pool under the file's registry slot, registering the file if it is new.
+   Caller holds sharedLatch. */
+{
+    PoolView *view = malloc(sizeof(PoolView));
+    if (view == NULL) return RC_MEMORY_ALLOCATION_FAIL;
+
+    latch(bufferMgr, &bufferMgr->poolLatch);
+    int fileId = -1, freeSlot = -1;
+    for (int f = 0; f < MAX_POOL_FILES && fileId < 0; f++) {
+        if (bufferMgr->files[f].name == NULL) {
+            if (freeSlot < 0) freeSlot = f;
+        } else if (strcmp(bufferMgr->files[f].name, pageFileName) == 0) {
+            fileId = f;  // Another handle already uses this file; share its cached pages
+        }
+    }
+    if (fileId < 0 && freeSlot >= 0) {
+        bufferMgr->files[freeSlot].name = strdup(pageFileName);
+        bufferMgr->files[freeSlot].numScans = 0;
+        atomic_store(&bufferMgr->files[freeSlot].scanPosition, NO_PAGE);
+        if (bufferMgr->files[freeSlot].name != NULL) fileId = freeSlot;
+    }
+    if (fileId >= 0) bufferMgr->files[fileId].refCount++;
+    unlatch(bufferMgr, &bufferMgr->poolLatch);
+
+    if (fileId < 0) {
+        free(view);
+        return RC_BUFFER_POOL_INIT_FAILED;  // Too many files attached to one pool
+    }
+
+    view->buffer = bufferMgr;
+    view->fileId = fileId;
+    bufferMgr->numViews++;
+
+    //init bm
+    bm->numPages = bufferMgr->numFrames;
+    bm->pageFile = bufferMgr->files[fileId].name;
+    bm->strategy = bufferMgr->strategy;
+    bm->mgmtData = view;
+    return RC_OK;
+}
+
+static RC dropFileFrames(Buffer *bufferMgr, int fileId)
+/* Empties every frame holding a page of the file, waiting for reads in flight.
+   Pins the caller leaked are discarded with the page. A page dirtied again since the flush is
+   written first; if that fails, its frame and the ones not reached yet stay and the error is
+   returned. Caller holds the flush and pool latches. */
+{
+    Frame *currentFrame = bufferMgr->head;
+
+    do {
+        if (currentFrame->fileId == fileId && currentFrame->currpage != NO_PAGE) {
+            int part = partitionOf(bufferMgr, fileId, currentFrame->currpage);
+            latch(bufferMgr, &bufferMgr->partLatch[part]);
+            while (bufferMgr->threadSafe && currentFrame->ioInProgress) {
+                pthread_cond_wait(&bufferMgr->ioDone[part], &bufferMgr->partLatch[part]);
+            }
+            if (currentFrame->fileId == fileId && currentFrame->currpage != NO_PAGE) {
+                if (currentFrame->dirty) {
+                    RC writeResult = writeFrame(bufferMgr, currentFrame);
+                    if (writeResult != RC_OK) {
+                        unlatch(bufferMgr, &bufferMgr->partLatch[part]);
+                        return writeResult;
+                    }
+                    atomic_fetch_add(&bufferMgr->numWrite, 1);
+                }
+                atomic_fetch_add(&currentFrame->version, 1);
+                atomic_fetch_add(&currentFrame->residency, 1);
+                removeFrame(bufferMgr, currentFrame);
+                if (currentFrame->prefetched) {
+                    currentFrame->prefetched = false;
+                    atomic_fetch_sub(&bufferMgr->prefetch.numUnused, 1);
+                }
+                currentFrame->currpage = NO_PAGE;
+                atomic_fetch_add(&currentFrame->version, 1);
+                clearDirty(bufferMgr, currentFrame);
+                atomic_store(&currentFrame->fixCount, 0);
+            }
+            unlatch(bufferMgr, &bufferMgr->partLatch[part]);
+        }
+        currentFrame = currentFrame->next;
+    } while (currentFrame != bufferMgr->head);
+    return RC_OK;
+}
+
+static RC detachView(BM_BufferPool *const bm)
+/* Flushes the handle's file and detaches it from its pool. The last handle on a file evicts
+   the file's pages and frees its registry slot; the last handle on a pool that is not kept
+   alive frees the pool. Caller holds sharedLatch. */
+{
+    PoolView *view = bm->mgmtData;
+    Buffer *bufferMgr = view->buffer;
+    int fileId = view->fileId;
+
+    // Flush all dirty pages of the file to disk
+    RC resultCode = forceFlushPool(bm);
+    if (resultCode != RC_OK) {
+        return resultCode;
+    }
+
+    pthread_mutex_lock(&bufferMgr->flushLatch);
+    if (bufferMgr->hot.save && bufferMgr->files[fileId].refCount == 1) {
+        saveHotList(bufferMgr, fileId);  // Best effort; without a list the next start is just cold
+    }
+    latch(bufferMgr, &bufferMgr->poolLatch);
+    while (bufferMgr->files[fileId].refCount == 1
+           && (writeBackPending(bufferMgr, fileId, NO_PAGE) || fileQueued(bufferMgr, fileId))) {
+        // Evicted since the flush; the writes use the file's name, and a failed write-back puts the page back
+        unlatch(bufferMgr, &bufferMgr->poolLatch);
+        waitForWriteBack(bufferMgr, fileId, NO_PAGE);
+        RC queueResult = drainWriteBehind(bufferMgr);
+        if (queueResult != RC_OK && fileQueued(bufferMgr, fileId)) {
+            pthread_mutex_unlock(&bufferMgr->flushLatch);
+            return queueResult;  // Still attached with its pages queued; shutting down again retries them
+        }
+        latch(bufferMgr, &bufferMgr->poolLatch);
+    }
+    if (bufferMgr->files[fileId].refCount == 1) {
+        dropPrefetches(bufferMgr, fileId);
+        resultCode = dropFileFrames(bufferMgr, fileId);
+        if (resultCode != RC_OK) {
+            unlatch(bufferMgr, &bufferMgr->poolLatch);
+            pthread_mutex_unlock(&bufferMgr->flushLatch);
+            return resultCode;  // Still attached with the page cached and dirty; shutting down again retries it
+        }
+        dropCompressedFile(bufferMgr, fileId);
+        for (int i = 0; i < GOVERNOR_STEP_PAGES; i++) {
+            if (bufferMgr->governor.ghosts[i].fileId == fileId) bufferMgr->governor.ghosts[i].pageNum = NO_PAGE;  // The slot may go to another file
+        }
+        free(bufferMgr->files[fileId].name);
+        bufferMgr->files[fileId].name = NULL;
+    }
+    bufferMgr->files[fileId].refCount--;
+    unlatch(bufferMgr, &bufferMgr->poolLatch);
+    pthread_mutex_unlock(&bufferMgr->flushLatch);
+
+    if (--bufferMgr->numViews == 0 && !bufferMgr->keepAlive) {
+        if (bufferMgr == sharedPool) sharedPool = NULL;
+        resultCode = destroyBuffer(bufferMgr);
+    }
+    free(view);
+
+    // Reset the buffer pool's metadata
+    bm->numPages = 0;
+    bm->pageFile = NULL;
+    bm->mgmtData = NULL;
+
+    return resultCode;
+}
+
+/* Resizing */
+static RC growPool(Buffer *bufferMgr, int count)
+/* Adds count empty frames. They are allocated before taking the pool latch and linked where the
+   victim search looks first. A page table that would get more than half full is rehashed under
+   all partition latches, which only holds up pins for the duration of the relinking. */
+{
+    Frame *frames = NULL;  // new frames chained through next
+    statlist *stats = NULL;
+    int newFrames = bufferMgr->numFrames + count;
+    int numBuckets = bufferMgr->numBuckets;
+    FrameLink *pageTable = NULL;
+
+    // The arena is only touched under the resize latch, which the caller holds
+    if (bufferMgr->arena.numFreeSlots < count && !growArena(bufferMgr, count - bufferMgr->arena.numFreeSlots)) {
+        return RC_MEMORY_ALLOCATION_FAIL;
+    }
+    for (int i = 0; i < count; i++) {
+        Frame *frame = newFrame(bufferMgr);
+        statlist *stat = malloc(sizeof(statlist));
+        if (frame == NULL || stat == NULL) {
+            if (frame != NULL) freeFrame(bufferMgr, frame);
+            free(stat);
+            while (frames != NULL) { Frame *next = frames->next; freeFrame(bufferMgr, frames); frames = next; }
+            while (stats != NULL) { statlist *next = stats->next; free(stats); stats = next; }
+            return RC_MEMORY_ALLOCATION_FAIL;
+        }
+        frame->next = frames;
+        frames = frame;
+        stat->fpt = frame;
+        stat->next = stats;
+        stats = stat;
+    }
+
+    Frame **dirtySet = malloc(sizeof(Frame *) * newFrames);
+    if (dirtySet == NULL) {
+        while (frames != NULL) { Frame *next = frames->next; freeFrame(bufferMgr, frames); frames = next; }
+        while (stats != NULL) { statlist *next = stats->next; free(stats); stats = next; }
+        return RC_MEMORY_ALLOCATION_FAIL;
+    }
+
+    while (numBuckets < 2 * newFrames) numBuckets *= 2;
+    if (numBuckets != bufferMgr->numBuckets) {
+        pageTable = calloc(numBuckets, sizeof(FrameLink));
+        if (pageTable == NULL) numBuckets = bufferMgr->numBuckets;  // Keep the old table, chains just get longer
+    }
+
+    latch(bufferMgr, &bufferMgr->poolLatch);
+    if (pageTable != NULL) {
+        FrameLink *oldTable = bufferMgr->pageTable;
+        int oldBuckets = bufferMgr->numBuckets;
+
+        for (int p = 0; p < NUM_LATCH_PARTITIONS; p++) latch(bufferMgr, &bufferMgr->partLatch[p]);
+        bufferMgr->pageTable = pageTable;
+        bufferMgr->numBuckets = numBuckets;
+        for (int b = 0; b < oldBuckets; b++) {
+            Frame *frame = oldTable[b];
+            while (frame != NULL) {
+                Frame *next = frame->hashNext;
+                insertFrame(bufferMgr, frame);
+                frame = next;
+            }
+        }
+        for (int p = NUM_LATCH_PARTITIONS - 1; p >= 0; p--) unlatch(bufferMgr, &bufferMgr->partLatch[p]);
+        retire(bufferMgr, oldTable);
+    }
+
+    while (frames != NULL) {
+        Frame *frame = frames;
+        frames = frames->next;
+
+        if (sweptByClock(bufferMgr)) {
+            // Right after the clock hand, so the next sweep finds it first
+            Frame *hand = bufferMgr->pointer;
+            frame->prev = hand;
+            frame->next = hand->next;
+            hand->next->prev = frame;
+            hand->next = frame;
+            if (hand == bufferMgr->tail) bufferMgr->tail = frame;
+        } else {
+            // At the head of the queue, where FIFO and LRU look for victims
+            frame->prev = bufferMgr->tail;
+            frame->next = bufferMgr->head;
+            bufferMgr->tail->next = frame;
+            bufferMgr->head->prev = frame;
+            bufferMgr->head = frame;
+        }
+    }
+
+    statlist *last = bufferMgr->stathead;
+    while (last->next != NULL) last = last->next;
+    last->next = stats;
+
+    latch(bufferMgr, &bufferMgr->dirtySet.latch);
+    memcpy(dirtySet, bufferMgr->dirtySet.frames, sizeof(Frame *) * bufferMgr->dirtySet.count);
+    Frame **oldDirtySet = bufferMgr->dirtySet.frames;
+    bufferMgr->dirtySet.frames = dirtySet;
+    unlatch(bufferMgr, &bufferMgr->dirtySet.latch);
+
+    bufferMgr->numFrames = newFrames;
+    unlatch(bufferMgr, &bufferMgr->poolLatch);
+    free(oldDirtySet);
+
+    return RC_OK;
+}
+
+static RC releaseOneFrame(Buffer *bufferMgr)
+/* Evicts one unpinned frame, preferring an empty one, and frees it. A dirty victim is written as
+   a miss writes one, after the pool latch is released, with the frame pinned so no victim search
+   takes it meanwhile. If the write fails the frame keeps its page, dirty. Caller holds the
+   resize latch. Returns RC_PINNED_PAGES_IN_BUFFER if every frame is pinned. */
+{
+    Frame *victim = NULL;
+    WriteBack writeBack;
+    RC resultCode;
+
+    latch(bufferMgr, &bufferMgr->poolLatch);
+    Frame *currentFrame = bufferMgr->head;
+    do {
+        if (currentFrame->currpage == NO_PAGE && claimFrame(bufferMgr, currentFrame)) {
+            victim = currentFrame;  // An empty frame costs nothing to give up
+            break;
+        }
+        currentFrame = currentFrame->next;
+    } while (currentFrame != bufferMgr->head);
+
+    if (victim == NULL) victim = selectVictim(bufferMgr);
+    if (victim == NULL) {
+        unlatch(bufferMgr, &bufferMgr->poolLatch);
+        return RC_PINNED_PAGES_IN_BUFFER;
+    }
+
+    writeBack.key.pageNum = NO_PAGE;
+    if (victim->currpage != NO_PAGE) {
+        bool dirty = victim->dirty, queued;
+        resultCode = handOffDirtyPage(bufferMgr, victim, &writeBack, &queued);
+        if (resultCode != RC_OK) {
+            unlatch(bufferMgr, &bufferMgr->poolLatch);
+            return resultCode;
+        }
+        atomic_fetch_add(&bufferMgr->stats.numEvictions, 1);
+        if (!dirty) atomic_fetch_add(&bufferMgr->stats.numCleanEvictions, 1);
+        rememberEvicted(bufferMgr, victim);  // Giving the frame back would have kept this page
+        if (victim->prefetched) {
+            victim->prefetched = false;
+            atomic_fetch_add(&bufferMgr->prefetch.numWasted, 1);
+            atomic_fetch_sub(&bufferMgr->prefetch.numUnused, 1);
+        }
+    }
+
+    if (writeBack.key.pageNum != NO_PAGE) {
+        // Publish the frame as an empty page being loaded, as evictAndPublish would, and write
+        // the old one without the pool latch
+        atomic_fetch_add(&victim->fixCount, 1);
+        atomic_fetch_add(&victim->version, 1);  // Odd until completeRead
+        victim->currpage = NO_PAGE;
+        victim->ioInProgress = true;
+        unlatch(bufferMgr, &bufferMgr->poolLatch);
+
+        resultCode = finishWriteBack(bufferMgr, victim, &writeBack);
+        if (resultCode != RC_OK) {
+            return resultCode;  // The frame holds the old page again, dirty and unpinned
+        }
+        completeRead(bufferMgr, victim, RC_OK, false);
+
+        latch(bufferMgr, &bufferMgr->poolLatch);
+        atomic_fetch_sub(&victim->fixCount, 1);
+    }
+
+    // Unlink the frame from the circular list and its statistics entry
+    if (bufferMgr->head == victim) bufferMgr->head = victim->next;
+    if (bufferMgr->tail == victim) bufferMgr->tail = victim->prev;
+    if (bufferMgr->pointer == victim) bufferMgr->pointer = victim->prev;
+    victim->prev->next = victim->next;
+    victim->next->prev = victim->prev;
+
+    statlist **link = &bufferMgr->stathead;
+    while ((*link)->fpt != victim) link = &(*link)->next;
+    statlist *stat = *link;
+    *link = stat->next;
+
+    bufferMgr->numFrames--;
+    atomic_fetch_add(&victim->version, 1);  // Odd for good: optimistic readers never accept it
+    releaseSlot(bufferMgr, victim->data);  // A reader still copying it fails the version check
+    pthread_rwlock_destroy(&victim->pageLatch);  // Unpinned, so nobody holds it
+    retire(bufferMgr, victim);
+    unlatch(bufferMgr, &bufferMgr->poolLatch);
+
+    free(stat);
+    return RC_OK;
+}
+
+RC saveHotPageList(BM_BufferPool *const bm)
+/* Writes the handle's file's hot-page list now, e.g. before a planned restart. */
+{
+    Buffer *bufferMgr = bufferOf(bm);
+    if (bufferMgr == NULL) return RC_FILE_HANDLE_NOT_INIT;
+
+    pthread_mutex_lock(&bufferMgr->flushLatch);
+    RC resultCode = saveHotList(bufferMgr, fileOf(bm));
+    pthread_mutex_unlock(&bufferMgr->flushLatch);
+    return resultCode;
+}
+
+static RC resizeBuffer(Buffer *bufferMgr, const int newNumPages)
+/* resizeBufferPool for a pool rather than a handle; the memory governor resizes pools with it. */
+{
+    RC resultCode = RC_OK;
+
+    latch(bufferMgr, &bufferMgr->resizeLatch);
+    if (newNumPages > bufferMgr->numFrames) {
+        resultCode = growPool(bufferMgr, newNumPages - bufferMgr->numFrames);
+    }
+    while (resultCode == RC_OK && bufferMgr->numFrames > newNumPages) {
+        resultCode = releaseOneFrame(bufferMgr);
+    }
+    if (bufferMgr->adapt.enabled) {
+        // Shadows of the old size would compare the strategies on the wrong pool
+        latch(bufferMgr, &bufferMgr->adapt.latch);
+        buildShadows(bufferMgr);
+        unlatch(bufferMgr, &bufferMgr->adapt.latch);
+    }
+    unlatch(bufferMgr, &bufferMgr->resizeLatch);
+
+    return resultCode;
+}
+
+/* Memory Governor */
+static long marginalGain(Buffer *bufferMgr)
+/* Ghost hits since the last rebalance: misses GOVERNOR_STEP_PAGES more frames would have saved. */
+{
+    return atomic_load(&bufferMgr->governor.numGhostHits) - bufferMgr->governor.gainMark;
+}
+
+static int compareGain(const void *a, const void *b)
+/* qsort order for pools: lowest marginal gain first. */
+{
+    long gainA = marginalGain(*(Buffer *const *) a);
+    long gainB = marginalGain(*(Buffer *const *) b);
+    return (gainA > gainB) - (gainA < gainB);
+}
+
+static RC fitBudget(Buffer *keep)
+/* Shrinks pools until all of them together fit memoryBudget, taking frames from the pools with
+   the lowest marginal gain first and never going below a pool's minimum. keep, the pool just
+   created or resized, gives frames up last. Minimums win over the budget. Returns
+   RC_PINNED_PAGES_IN_BUFFER if pinned frames kept a pool from shrinking. Caller holds governorLatch. */
+{
+    RC resultCode = RC_OK;
+    long excess = -memoryBudget / PAGE_SIZE;
+    int numPools = 0;
+
+    if (memoryBudget == 0) return RC_OK;
+    for (Buffer *pool = governedPools; pool != NULL; pool = pool->governor.next) {
+        excess += pool->numFrames;
+        numPools++;
+    }
+    if (excess <= 0) return RC_OK;
+
+    Buffer **order = malloc(sizeof(Buffer *) * numPools);
+    if (order == NULL) return RC_MEMORY_ALLOCATION_FAIL;
+    int count = 0;
+    for (Buffer *pool = governedPools; pool != NULL; pool = pool->governor.next) {
+        if (pool != keep) order[count++] = pool;
+    }
+    qsort(order, count, sizeof(Buffer *), compareGain);
+    if (keep != NULL) order[count++] = keep;
+
+    for (int i = 0; i < count && excess > 0; i++) {
+        Buffer *pool = order[i];
+        int spare = pool->numFrames - pool->governor.minFrames;
+        if (spare <= 0) continue;
+        int before = pool->numFrames;
+        RC rc = resizeBuffer(pool, before - (int) ((excess < spare) ? excess : spare));
+        if (rc != RC_OK) resultCode = rc;
+        excess -= before - pool->numFrames;
+    }
+    free(order);
+
+    return resultCode;
+}
+
+static void admitPool(Buffer *bufferMgr)
+/* Makes room for a new pool within the budget. Best effort: frames pinned elsewhere stay. */
+{
+    pthread_mutex_lock(&governorLatch);
+    fitBudget(bufferMgr);
+    pthread_mutex_unlock(&governorLatch);
+}
+
+RC setMemoryBudget(const long totalBytes)
+/* Caps the frame memory of all buffer pools in the process at totalBytes (0 removes the cap),
+   shrinking pools at once if they are over it. Pools created later are admitted within it. */
+{
+    if (totalBytes < 0) {
+        return RC_INVALID_INPUT;
+    }
+
+    pthread_mutex_lock(&governorLatch);
+    memoryBudget = totalBytes;
+    RC resultCode = fitBudget(NULL);
+    pthread_mutex_unlock(&governorLatch);
+
+    return resultCode;
+}
+
+RC setPoolMinimum(BM_BufferPool *const bm, const int minPages)
+/* Sets the frames the governor leaves the handle's pool at least (GOVERNOR_MIN_PAGES by default),
+   growing the pool to it now if it is smaller. */
+{
+    Buffer *bufferMgr = bufferOf(bm);
+    RC resultCode = RC_OK;
+
+    if (bufferMgr == NULL) {
+        return RC_FILE_HANDLE_NOT_INIT;
+    }
+    if (minPages <= 0) {
+        return RC_INVALID_INPUT;
+    }
+
+    pthread_mutex_lock(&governorLatch);
+    bufferMgr->governor.minFrames = minPages;
+    if (bufferMgr->numFrames < minPages) {
+        resultCode = resizeBuffer(bufferMgr, minPages);
+        if (resultCode == RC_OK) resultCode = fitBudget(bufferMgr);
+    }
+    pthread_mutex_unlock(&governorLatch);
+
+    return resultCode;
+}
+
+RC rebalancePools(void)
+/* Moves up to GOVERNOR_STEP_PAGES frames to the pool whose ghosts were hit most since the last
+   call. Frames left in the budget are granted first; the rest come from the pool with the
+   lowest gain still above its minimum, and only if it gained less than half as much, so two
+   pools with similar gains do not trade frames back and forth. Starts a new measuring window. */
+{
+    Buffer *receiver = NULL, *donor = NULL;
+    RC resultCode = RC_OK;
+    long freePages = 0;
+
+    pthread_mutex_lock(&governorLatch);
+    if (memoryBudget > 0) freePages = memoryBudget / PAGE_SIZE;
+    for (Buffer *pool = governedPools; pool != NULL; pool = pool->governor.next) {
+        freePages -= pool->numFrames;
+        if (marginalGain(pool) > 0 && (receiver == NULL || marginalGain(pool) > marginalGain(receiver))) {
+            receiver = pool;
+        }
+    }
+    for (Buffer *pool = governedPools; pool != NULL; pool = pool->governor.next) {
+        if (pool != receiver && pool->numFrames > pool->governor.minFrames
+                && (donor == NULL || marginalGain(pool) < marginalGain(donor))) {
+            donor = pool;
+        }
+    }
+
+    if (receiver != NULL) {
+        int grant = (freePages > GOVERNOR_STEP_PAGES) ? GOVERNOR_STEP_PAGES : (freePages > 0 ? (int) freePages : 0);
+        if (grant < GOVERNOR_STEP_PAGES && donor != NULL && 2 * marginalGain(donor) < marginalGain(receiver)) {
+            int take = GOVERNOR_STEP_PAGES - grant;
+            int before = donor->numFrames;
+            if (take > before - donor->governor.minFrames) take = before - donor->governor.minFrames;
+            resultCode = resizeBuffer(donor, before - take);
+            grant += before - donor->numFrames;  // Pinned frames may have kept some
+        }
+        if (grant > 0) {
+            RC rc = resizeBuffer(receiver, receiver->numFrames + grant);
+            if (rc != RC_OK) resultCode = rc;
+        }
+    }
+    for (Buffer *pool = governedPools; pool != NULL; pool = pool->governor.next) {
+        pool->governor.gainMark = atomic_load(&pool->governor.numGhostHits);
+    }
+    pthread_mutex_unlock(&governorLatch);
+
+    return resultCode;
+}
+
+RC resizeBufferPool(BM_BufferPool *const bm, const int newNumPages)
+/* Grows or shrinks the handle's pool to newNumPages frames while it stays in use; cached pages
+   survive unless their frame is given up. Shrinking evicts one frame per pool latch hold, so
+   pins carry on in between. If pinned frames keep the pool larger than newNumPages it stops
+   there and returns RC_PINNED_PAGES_IN_BUFFER. Under a memory budget, growing shrinks the other
+   pools to make room, and this one too if they are at their minimums. bm->numPages always holds
+   the size reached. */
+{
+    Buffer *bufferMgr = bufferOf(bm);
+    RC resultCode;
+
+    if (bufferMgr == NULL) {
+        return RC_FILE_HANDLE_NOT_INIT;
+    }
+    if (newNumPages <= 0) { //input check
+        return RC_WRITE_FAILED;
+    }
+
+    pthread_mutex_lock(&governorLatch);
+    resultCode = resizeBuffer(bufferMgr, newNumPages);
+    if (resultCode == RC_OK) resultCode = fitBudget(bufferMgr);
+    bm->numPages = bufferMgr->numFrames;
+    pthread_mutex_unlock(&governorLatch);
+
+    return resultCode;
+}
+
+/************************************Assignment Functions**************************************/
+
+void initPoolOptions(BM_PoolOptions *const opts)
+/* Fills opts with the defaults used by initBufferPool. */
+{
+    memset(opts, 0, sizeof(BM_PoolOptions));
+    opts->threadSafe = false;
+    opts->backgroundWriter = false;
+    opts->bgWriterDelayMs = 20;
+    opts->bgWriterMaxPages = 16;
+    opts->bgWriterLowWater = 0.5;
+    opts->bgWriterHighWater = 0.8;
+    opts->asyncPrefetch = false;
+    opts->hugePages = false;
+    opts->hugeTlb = false;
+    opts->writeBehind = false;
+    opts->writeBehindPages = 64;
+    opts->adaptiveStrategy = false;
+    opts->adaptWindowPins = 2048;
+    opts->compressedCache = false;
+    opts->compressedCacheBytes = 4 * 1024 * 1024;
+    opts->pinCache = false;
+}
+
+RC initBufferPool(BM_BufferPool *const bm, const char *const pageFileName,
+                  const int numPages, ReplacementStrategy strategy,
+                  void *stratData)
+{
+    return initBufferPoolWithOptions(bm, pageFileName, numPages, strategy, stratData, NULL);
+}
+
+RC initBufferPoolWithOptions(BM_BufferPool *const bm, const char *const pageFileName,
+                  const int numPages, ReplacementStrategy strategy,
+                  void *stratData, const BM_PoolOptions *const opts)
+/* Creates a private pool holding pages of pageFileName only. */
+{
+    Buffer *bf;
+    RC resultCode = createBuffer(&bf, numPages, strategy, stratData, opts);
+    if (resultCode != RC_OK) {
+        return resultCode;
+    }
+    admitPool(bf);
+
+    pthread_mutex_lock(&sharedLatch);
+    resultCode = attachView(bm, bf, pageFileName);
+    pthread_mutex_unlock(&sharedLatch);
+    if (resultCode != RC_OK) {
+        destroyBuffer(bf);
+    } else if (bf->hot.preload) {
+        preloadHotList(bm);
+    }
+    return resultCode;
+}
+
+RC initSharedBufferPool(const int numPages, ReplacementStrategy strategy,
+                        const BM_PoolOptions *const opts)
+/* Creates the process-wide pool used by attachBufferPool. It lives until shutdownSharedBufferPool. */
+{
+    RC resultCode = RC_BUFFER_POOL_INIT_FAILED;  // There already is a shared pool
+
+    pthread_mutex_lock(&sharedLatch);
+    if (sharedPool == NULL) {
+        resultCode = createBuffer(&sharedPool, numPages, strategy, NULL, opts);
+        if (resultCode == RC_OK) {
+            sharedPool->keepAlive = true;
+            admitPool(sharedPool);
+        } else {
+            sharedPool = NULL;
+        }
+    }
+    pthread_mutex_unlock(&sharedLatch);
+
+    return resultCode;
+}
+
+RC shutdownSharedBufferPool(void)
+/* Frees the shared pool. Fails while handles are still attached to it. */
+{
+    RC resultCode = RC_OK;
+
+    pthread_mutex_lock(&sharedLatch);
+    if (sharedPool == NULL) {
+        resultCode = RC_FILE_HANDLE_NOT_INIT;
+    } else if (sharedPool->numViews > 0) {
+        resultCode = RC_PINNED_PAGES_IN_BUFFER;
+    } else {
+        resultCode = destroyBuffer(sharedPool);
+        sharedPool = NULL;
+    }
+    pthread_mutex_unlock(&sharedLatch);
+
+    return resultCode;
+}
+
+RC attachBufferPool(BM_BufferPool *const bm, const char *const pageFileName)
+/* Initialises bm as a handle on pageFileName in the shared pool, so all files compete for one
+   set of frames. Without initSharedBufferPool a default shared pool is created here and freed
+   again when its last handle is shut down. */
+{
+    RC resultCode = RC_OK;
+
+    pthread_mutex_lock(&sharedLatch);
+    if (sharedPool == NULL) {
+        BM_PoolOptions options;
+        initPoolOptions(&options);
+        options.threadSafe = true;
+        resultCode = createBuffer(&sharedPool, SHARED_POOL_DEFAULT_PAGES, RS_LRU, NULL, &options);
+        if (resultCode == RC_OK) {
+            admitPool(sharedPool);
+        } else {
+            sharedPool = NULL;
+        }
+    }
+    bool firstView = false;
+    if (resultCode == RC_OK) {
+        resultCode = attachView(bm, sharedPool, pageFileName);
+        if (resultCode != RC_OK && sharedPool->numViews == 0 && !sharedPool->keepAlive) {
+            destroyBuffer(sharedPool);
+            sharedPool = NULL;
+        }
+        firstView = (resultCode == RC_OK && sharedPool->files[fileOf(bm)].refCount == 1);
+    }
+    pthread_mutex_unlock(&sharedLatch);
+
+    // Only the first handle on a file warms it up; later ones find the pages cached
+    if (firstView && bufferOf(bm)->hot.preload) {
+        preloadHotList(bm);
+    }
+
+    return resultCode;
+}
+
+RC shutdownBufferPool(BM_BufferPool *const bm)
+/* Shuts down the handle, writing its dirty pages back to disk. A private pool is freed with it;
+   on the shared pool only this file's pages are released. */
+{
+    if (bm->mgmtData == NULL) {
+        return RC_FILE_HANDLE_NOT_INIT;  // Never initialised or already shut down
+    }
+
+    pthread_mutex_lock(&sharedLatch);
+    RC resultCode = detachView(bm);
+    pthread_mutex_unlock(&sharedLatch);
+
+    return resultCode;
+}
+
+static int collectDirtyPages(Buffer *bufferMgr, int fileId, PageNumber **pages)
+/* Page numbers of the file's dirty frames, sorted, in a new array (NULL if there are none). */
+{
+    int count = 0;
+
+    latch(bufferMgr, &bufferMgr->dirtySet.latch);
+    *pages = (bufferMgr->dirtySet.count > 0) ? malloc(sizeof(PageNumber) * bufferMgr->dirtySet.count) : NULL;
+    for (int i = 0; *pages != NULL && i < bufferMgr->dirtySet.count; i++) {
+        Frame *frame = bufferMgr->dirtySet.frames[i];
+        if (frame->fileId == fileId && frame->currpage != NO_PAGE) {
+            (*pages)[count++] = frame->currpage;
+        }
+    }
+    unlatch(bufferMgr, &bufferMgr->dirtySet.latch);
+
+    if (count > 0) qsort(*pages, count, sizeof(PageNumber), comparePageNumbers);
+    return count;
+}
+
+static RC writeDirtyPages(Buffer *bufferMgr, int fileId, SM_FileHandle *fileHandle,
+                          const PageNumber *pages, int count)
+/* Writes those of the sorted pages that are still resident and dirty. The frames are pinned under
+   the pool latch and written after it is released, each run of consecutive pages with a single
+   writeBlocks call. A page that fails to write is marked dirty again. */
+{
+    Frame **batch = malloc(sizeof(Frame *) * count);
+    SM_PageHandle *runData = malloc(sizeof(SM_PageHandle) * count);
+    int batchSize = 0;
+    RC resultCode = RC_OK;
+
+    if (batch == NULL || runData == NULL) {
+        free(batch);
+        free(runData);
+        return RC_MEMORY_ALLOCATION_FAIL;
+    }
+
+    latch(bufferMgr, &bufferMgr->poolLatch);
+    for (int i = 0; i < count; i++) {
+        int part = partitionOf(bufferMgr, fileId, pages[i]);
+        latch(bufferMgr, &bufferMgr->partLatch[part]);
+        Frame *frame = lookupFrame(bufferMgr, fileId, pages[i]);
+        unlatch(bufferMgr, &bufferMgr->partLatch[part]);
+        if (frame != NULL && pinForFlush(bufferMgr, frame, true)) {
+            batch[batchSize++] = frame;
+        }
+    }
+    unlatch(bufferMgr, &bufferMgr->poolLatch);
+
+    for (int done = 0; done < batchSize; ) {
+        int runLength = 1;
+        while (done + runLength < batchSize
+               && batch[done + runLength]->currpage == batch[done]->currpage + runLength) {
+            runLength++;
+        }
+        for (int i = 0; i < runLength; i++) runData[i] = batch[done + i]->data;
+
+        // Shared latches wait for writers holding a page exclusively to finish their change.
+        // A flush by a thread holding one itself fails to latch (EDEADLK) and writes the page as is.
+        bool latched[runLength];
+        for (int i = 0; i < runLength; i++) {
+            latched[i] = pthread_rwlock_rdlock(&batch[done + i]->pageLatch) == 0;
+        }
+        RC writeResult = writeBlocks(batch[done]->currpage, runLength, fileHandle, runData);
+        for (int i = 0; i < runLength; i++) {
+            if (latched[i]) pthread_rwlock_unlock(&batch[done + i]->pageLatch);
+            if (writeResult == RC_OK) {
+                atomic_fetch_add(&bufferMgr->numWrite, 1);  // Increment write count
+            } else {
+                setDirty(bufferMgr, batch[done + i]);
+            }
+            atomic_fetch_sub(&batch[done + i]->fixCount, 1);
+        }
+        if (writeResult != RC_OK) resultCode = writeResult;
+        done += runLength;
+    }
+
+    free(batch);
+    free(runData);
+    return resultCode;
+}
+
+static RC flushDirtyPages(BM_BufferPool *const bm, int pagesPerStep, int pauseMs)
+/* Writes every page of the handle's file that is dirty now, in page order, pagesPerStep pages at
+   a time (all at once if not positive) with pauseMs between steps. The write-behind queue is
+   written first, for every file of the pool, and write-backs of the file's evicted pages are
+   waited for. */
+{
+    Buffer *bufferMgr = bufferOf(bm);
+    SM_FileHandle fileHandle;
+    PageNumber *pages;
+
+    if (bufferMgr == NULL) {
+        return RC_FILE_HANDLE_NOT_INIT;
+    }
+    RC queueResult = drainWriteBehind(bufferMgr);
+    if (queueResult != RC_OK) {
+        return queueResult;
+    }
+    waitForWriteBack(bufferMgr, fileOf(bm), NO_PAGE);
+    int count = collectDirtyPages(bufferMgr, fileOf(bm), &pages);
+    if (count == 0) {
+        free(pages);
+        return RC_OK;
+    }
+
+    // Open the page file
+    RC resultCode = openPageFile(bm->pageFile, &fileHandle);
+    if (resultCode != RC_OK) {
+        free(pages);
+        return resultCode;
+    }
+
+    if (pagesPerStep <= 0) pagesPerStep = count;
+    for (int i = 0; i < count && resultCode == RC_OK; i += pagesPerStep) {
+        if (i > 0 && pauseMs > 0) {
+            struct timespec pause = {pauseMs / 1000, (long)(pauseMs % 1000) * 1000000L};
+            nanosleep(&pause, NULL);
+        }
+        int step = (count - i < pagesPerStep) ? count - i : pagesPerStep;
+        resultCode = writeDirtyPages(bufferMgr, fileOf(bm), &fileHandle, pages + i, step);
+    }
+
+    // Close the page file
+    closePageFile(&fileHandle);
+    free(pages);
+    return resultCode;
+}
+
+RC forceFlushPool(BM_BufferPool *const bm)
+/* Writes all dirty pages of the handle's file back to disk, ensuring data consistency.
+   The pages come from the dirty set and are written in page order, adjacent pages together. */
+{
+    return flushDirtyPages(bm, 0, 0);
+}
+
+RC checkpointPool(BM_BufferPool *const bm, const int pagesPerStep, const int pauseMs)
+/* Incremental checkpoint: like forceFlushPool, but spreads the writes out, pagesPerStep pages
+   at a time with pauseMs between steps. Pins and misses carry on meanwhile. Pages dirtied
+   after the call starts are left for the next checkpoint. */
+{
+    return flushDirtyPages(bm, pagesPerStep, pauseMs);
+}
+
+// Buffer Manager Interface Access Pages
+static Frame *pinnedFrameOf(BM_BufferPool *const bm, BM_PageHandle *const page)
+/* The frame a pinned handle refers to, or NULL if the handle holds no pin (never pinned,
+   failed pin, already unpinned) or refers to another page. Scratch pages count as any view's. */
+{
+    Frame *frame = page->frameRef;
+    if (frame == NULL || frame->currpage != page->pageNum
+        || (frame->fileId != fileOf(bm) && frame->fileId != SCRATCH_FILE)
+        || atomic_load(&frame->fixCount) <= 0) {
+        return NULL;
+    }
+    return frame;
+}
+
+static bool isScratchHandle(BM_PageHandle *const page)
+/* Whether the handle was filled by allocScratchPage or pinScratchPage (and not unpinned since). */
+{
+    Frame *frame = page->frameRef;
+    return frame != NULL && frame->fileId == SCRATCH_FILE && frame->currpage == page->pageNum;
+}
+
+static void releasePin(Frame *frame)
+/* Drops one pin. The usage counter is left alone: only the clock hand counts it down. */
+{
+    atomic_fetch_sub(&frame->fixCount, 1);  // Decrement the fix count
+}
+
+static void releaseLatch(Frame *frame, BM_PageHandle *const page)
+/* Releases the page latch the handle holds on the frame, if any. */
+{
+    if (page->latchMode == BM_LATCH_EXCLUSIVE) {
+        atomic_fetch_add(&frame->version, 1);  // Even again: optimistic readers may copy the page
+    }
+    if (page->latchMode != BM_LATCH_NONE) {
+        pthread_rwlock_unlock(&frame->pageLatch);
+    }
+    page->latchMode = BM_LATCH_NONE;
+}
+
+RC markDirtyRef(BM_BufferPool *const bm, BM_PageHandle *const page)
+/* markDirty for a handle filled by pinPage: goes straight to the pinned frame. */
+{
+    Buffer *bufferMgr = bufferOf(bm);
+    if (bufferMgr == NULL) return RC_FILE_HANDLE_NOT_INIT;
+
+    Frame *frame = pinnedFrameOf(bm, page);
+    if (frame == NULL) return RC_READ_NON_EXISTING_PAGE;
+
+    setDirty(bufferMgr, frame);  // Mark the frame as dirty
+    return RC_OK;
+}
+
+RC unpinPageRef(BM_BufferPool *const bm, BM_PageHandle *const page)
+/* unpinPage for a handle filled by pinPage: drops the pin on its frame without a page table
+   lookup. The handle's frame reference is cleared, so unpinning twice fails cleanly. */
+{
+    if (bufferOf(bm) == NULL) return RC_FILE_HANDLE_NOT_INIT;
+
+    Frame *frame = pinnedFrameOf(bm, page);
+    if (frame == NULL) return RC_READ_NON_EXISTING_PAGE;  // Not pinned through this handle
+
+    page->frameRef = NULL;
+    releaseLatch(frame, page);
+    releasePin(frame);
+    return RC_OK;
+}
+
+RC forcePageRef(BM_BufferPool *const bm, BM_PageHandle *const page)
+/* forcePage for a handle filled by pinPage: writes the pinned frame back to its file. */
+{
+    Buffer *bufferMgr = bufferOf(bm);
+    if (bufferMgr == NULL) return RC_FILE_HANDLE_NOT_INIT;
+
+    Frame *frame = pinnedFrameOf(bm, page);
+    if (frame == NULL) return RC_READ_NON_EXISTING_PAGE;
+    if (frame->fileId == SCRATCH_FILE) return RC_OK;  // Scratch pages are never flushed
+
+    // Without a latch of its own, the caller waits for a writer holding the page exclusively
+    bool latched = page->latchMode == BM_LATCH_NONE && pthread_rwlock_rdlock(&frame->pageLatch) == 0;
+    RC writeResult = writeFrame(bufferMgr, frame);
+    if (latched) pthread_rwlock_unlock(&frame->pageLatch);
+    if (writeResult != RC_OK) {
+        return RC_WRITE_FAILED;
+    }
+    atomic_fetch_add(&bufferMgr->numWrite, 1);  // Increment write count
+    return RC_OK;
+}
+
+RC markDirty(BM_BufferPool *const bm, BM_PageHandle *const page)
+/* Marks the frame corresponding to the given page as dirty, indicating that it has been modified.
+   Works for any handle naming a resident page; finds the frame through the page table. */
+{
+    Buffer *bufferMgr = bufferOf(bm);
+    if (bufferMgr == NULL) return RC_FILE_HANDLE_NOT_INIT;
+    if (isScratchHandle(page)) return markDirtyRef(bm, page);  // Not in the page table under this file
+    int fileId = fileOf(bm);
+    int part = partitionOf(bufferMgr, fileId, page->pageNum);
+
+    // Look up the frame associated with the page
+    latch(bufferMgr, &bufferMgr->partLatch[part]);
+    Frame *currentFrame = lookupFrame(bufferMgr, fileId, page->pageNum);
+    if (currentFrame != NULL) {
+        setDirty(bufferMgr, currentFrame);  // Mark the frame as dirty
+    }
+    unlatch(bufferMgr, &bufferMgr->partLatch[part]);
+
+    // Page not found
+    return (currentFrame != NULL) ? RC_OK : RC_READ_NON_EXISTING_PAGE;
+}
+
+RC unpinPage(BM_BufferPool *const bm, BM_PageHandle *const page)
+/* Unpins the page from the buffer pool, reducing its fix count.
+   Works for any handle naming a pinned page; finds the frame through the page table. */
+{
+    Buffer *bufferMgr = bufferOf(bm);
+    if (bufferMgr == NULL) return RC_FILE_HANDLE_NOT_INIT;
+    if (isScratchHandle(page)) return unpinPageRef(bm, page);
+    int fileId = fileOf(bm);
+    int part = partitionOf(bufferMgr, fileId, page->pageNum);
+    RC resultCode = RC_READ_NON_EXISTING_PAGE;  // Page not found or already unpinned
+
+    // Look up the frame associated with the page
+    latch(bufferMgr, &bufferMgr->partLatch[part]);
+    Frame *currentFrame = lookupFrame(bufferMgr, fileId, page->pageNum);
+    if (currentFrame != NULL && atomic_load(&currentFrame->fixCount) > 0) {
+        releaseLatch(currentFrame, page);
+        releasePin(currentFrame);
+        page->frameRef = NULL;
+        resultCode = RC_OK;
+    }
+    unlatch(bufferMgr, &bufferMgr->partLatch[part]);
+
+    return resultCode;
+}
+
+RC forcePage(BM_BufferPool *const bm, BM_PageHandle *const page)
+/* Writes the given page from the buffer pool to disk, ensuring the page is saved. */
+{
+    Buffer *bufferMgr = bufferOf(bm);
+    SM_FileHandle fileHandle;
+
+    if (bufferMgr == NULL) {
+        return RC_FILE_HANDLE_NOT_INIT;
+    }
+    if (isScratchHandle(page)) {
+        return RC_OK;  // Scratch pages are never flushed
+    }
+
+    // Open the page file
+    RC resultCode = openPageFile(bm->pageFile, &fileHandle);
+    if (resultCode != RC_OK) {
+        return RC_FILE_NOT_FOUND;
+    }
+
+    // Write the page data to disk
+    resultCode = writeBlock(page->pageNum, &fileHandle, page->data);
+    if (resultCode != RC_OK) {
+        closePageFile(&fileHandle);  // Ensure the file is closed on error
+        return RC_WRITE_FAILED;
+    }
+
+    // Increment the write count in the buffer manager
+    atomic_fetch_add(&bufferMgr->numWrite, 1);
+
+    // Close the page file
+    closePageFile(&fileHandle);
+    return RC_OK;
+}
+
+static bool tryReadOptimistic(Buffer *bufferMgr, int fileId, PageNumber pageNum, char *dest,
+                              int offset, int length)
+/* One optimistic read: finds the frame without latches, copies the bytes and checks that the
+   frame's version did not change meanwhile. Frames and page tables are only freed with the pool,
+   so following stale links is safe; it may just miss the page. */
+{
+    int numBuckets = atomic_load(&bufferMgr->numBuckets);  // Before the table: never indexes past it
+    FrameLink *table = atomic_load(&bufferMgr->pageTable);
+    Frame *frame = table[hashOf(fileId, pageNum) & (unsigned int)(numBuckets - 1)];
+
+    // A chain can change under us; give up after a pool's worth of frames
+    for (int steps = 0; frame != NULL && (frame->currpage != pageNum || frame->fileId != fileId); steps++) {
+        if (steps > bufferMgr->numFrames) return false;
+        frame = frame->hashNext;
+    }
+    if (frame == NULL) return false;
+
+    unsigned int version = atomic_load_explicit(&frame->version, memory_order_acquire);
+    if ((version & 1) != 0 || frame->currpage != pageNum || frame->fileId != fileId) {
+        return false;  // Being loaded, evicted or dropped
+    }
+    memcpy(dest, frame->data + offset, length);
+    atomic_thread_fence(memory_order_acquire);
+    return atomic_load_explicit(&frame->version, memory_order_relaxed) == version;
+}
+
+RC readPageOptimistic(BM_BufferPool *const bm, const PageNumber pageNum, char *dest,
+                      const int offset, const int length)
+/* Copies length bytes at offset of the page into dest without pinning it, as long as the page is
+   resident and nothing changes it during the copy; otherwise pins, copies and unpins.
+   Like a shared pin, it only excludes writers holding the page's exclusive latch (pinPageExclusive,
+   or latchPage and unlatchPage around a change made through a plain pin): the latch keeps the
+   version odd from before the first byte changes until after the last, and a copy that overlaps
+   it is thrown away. markDirty comes after the change, too late to tell.
+   The unpinned path touches no shared cache line, but it is not a reference for the
+   replacement strategy either. */
+{
+    Buffer *bufferMgr = bufferOf(bm);
+    BM_PageHandle page;
+
+    if (bufferMgr == NULL) return RC_FILE_HANDLE_NOT_INIT;
+    if (pageNum < 0 || offset < 0 || length < 0 || offset + length > PAGE_SIZE) return RC_IM_KEY_NOT_FOUND;
+
+    for (int attempt = 0; attempt < OPTIMISTIC_RETRIES; attempt++) {
+        if (tryReadOptimistic(bufferMgr, fileOf(bm), pageNum, dest, offset, length)) {
+            atomic_fetch_add(&bufferMgr->stats.numOptimisticReads, 1);
+            return RC_OK;
+        }
+    }
+
+    // Not resident or changing: a shared pin waits for the load or a writer, or loads the page
+    atomic_fetch_add(&bufferMgr->stats.numOptimisticFallbacks, 1);
+    RC resultCode = pinPageShared(bm, &page, pageNum);
+    if (resultCode != RC_OK) return resultCode;
+    memcpy(dest, page.data + offset, length);
+    return unpinPageRef(bm, &page);
+}
+
+RC pinPage(BM_BufferPool *const bm, BM_PageHandle *const page, const PageNumber pageNum)
+/* Pins the specified page in the buffer pool using the appropriate replacement strategy. */
+{
+    return pinPageWithRing(bm, page, pageNum, NULL);
+}
+
+RC pinPageWithRing(BM_BufferPool *const bm, BM_PageHandle *const page, const PageNumber pageNum,
+                   BM_AccessRing *ring)
+/* Like pinPage, but once the ring is full, misses recycle the frames of the ring's own earlier
+   pages (when nobody else uses them) rather than evicting other pages, so the caller occupies
+   at most about ring-size frames. A NULL ring pins normally. */
+{
+    Buffer *bufferMgr = bufferOf(bm);
+    page->frameRef = NULL;  // Until the pin succeeds
+    page->latchMode = BM_LATCH_NONE;
+    if (bufferMgr == NULL) {
+        return RC_FILE_HANDLE_NOT_INIT;  // Pool not initialised or already shut down
+    }
+
+    // Validate the page number
+    if (pageNum < 0) {
+        return RC_IM_KEY_NOT_FOUND;
+    }
+    tracePin(bufferMgr, fileOf(bm), pageNum);
+    adaptSample(bufferMgr, fileOf(bm), pageNum);
+
+    // Determine the replacement strategy and pin the page accordingly
+    switch (bufferMgr->strategy) {
+        case RS_FIFO:
+        case RS_LRU:
+        case RS_CLOCK:
+        case RS_GCLOCK:
+            return pinWithStrategy(bufferMgr, fileOf(bm), page, pageNum, ring);
+        case RS_LRU_K:
+            return pinLRUK(bm, page, pageNum);
+        default:
+            return RC_IM_KEY_NOT_FOUND;  // Unknown replacement strategy
+    }
+}
+
+static int comparePageOfMiss(const void *a, const void *b)
+/* qsort order for pinPages' misses: by page number. */
+{
+    const Frame *fa = *(Frame *const *)a;
+    const Frame *fb = *(Frame *const *)b;
+    return (fa->currpage > fb->currpage) - (fa->currpage < fb->currpage);
+}
+
+static RC loadMisses(Buffer *bufferMgr, int fileId, BM_PageHandle *const pages, const int *missIdx,
+                     int numMisses)
+/* Loads the pages of pinPages' misses: opens the file, growing it if needed, then claims and
+   publishes a victim for each under one pool latch hold, then writes the victims' dirty pages
+   back and reads consecutive pages with one readBlocks call per run. Either every miss ends up
+   pinned with its handle filled, or none does. */
+{
+    SM_FileHandle fileHandle;
+    Frame **loaded = malloc(numMisses * sizeof(Frame *));
+    SM_PageHandle *runData = malloc(numMisses * sizeof(SM_PageHandle));
+    CacheReservation *reservations = malloc(numMisses * sizeof(CacheReservation));
+    WriteBack *writeBacks = malloc(numMisses * sizeof(WriteBack));
+    int numLoaded = 0;
+    int done = 0;
+    PageNumber maxPage = 0;
+
+    for (int i = 0; i < numMisses; i++) {
+        if (pages[missIdx[i]].pageNum > maxPage) maxPage = pages[missIdx[i]].pageNum;
+    }
+
+    // Open and grow the file before taking the pool latch; the caller's handle keeps it attached
+    RC resultCode = openForLoad(bufferMgr, fileId, maxPage, true, &fileHandle);
+    if (resultCode != RC_OK || loaded == NULL || runData == NULL || reservations == NULL || writeBacks == NULL) {
+        if (resultCode == RC_OK) closePageFile(&fileHandle);
+        free(loaded);
+        free(runData);
+        free(reservations);
+        free(writeBacks);
+        return (resultCode != RC_OK) ? resultCode : RC_MEMORY_ALLOCATION_FAIL;
+    }
+
+    latch(bufferMgr, &bufferMgr->poolLatch);
+
+    // Misses still being written back out of other frames are read once they are on disk
+    for (int i = 0; i < numMisses; i++) {
+        if (writeBackPending(bufferMgr, fileId, pages[missIdx[i]].pageNum)) {
+            unlatch(bufferMgr, &bufferMgr->poolLatch);
+            waitForWriteBack(bufferMgr, fileId, pages[missIdx[i]].pageNum);
+            latch(bufferMgr, &bufferMgr->poolLatch);
+            i = -1;  // Others may have started meanwhile
+        }
+    }
+
+    // Pin the misses another thread loaded while we waited for the pool latch before evicting
+    // anything, so no victim is one of them
+    for (int i = 0; i < numMisses; i++) {
+        BM_PageHandle *page = &pages[missIdx[i]];
+        Frame *frame = alreadyPinned(bufferMgr, fileId, page->pageNum, NULL);
+        if (frame != NULL) {
+            atomic_fetch_add(&bufferMgr->stats.numHits, 1);
+            page->data = frame->data;
+            page->frameRef = frame;
+        }
+    }
+
+    for (int i = 0; i < numMisses && resultCode == RC_OK; i++) {
+        BM_PageHandle *page = &pages[missIdx[i]];
+        if (page->frameRef != NULL) continue;
+
+        Frame *victim = selectVictim(bufferMgr);
+        if (victim == NULL) {
+            resultCode = RC_IM_NO_MORE_ENTRIES;  // Fewer free frames than misses
+            break;
+        }
+        resultCode = evictAndPublish(bufferMgr, victim, fileId, page->pageNum, false,
+                                     &reservations[numLoaded], &writeBacks[numLoaded]);
+        if (resultCode == RC_OK) {
+            atomic_fetch_add(&bufferMgr->stats.numMisses, 1);
+            page->data = victim->data;
+            page->frameRef = victim;
+            loaded[numLoaded++] = victim;
+        }
+    }
+    unlatch(bufferMgr, &bufferMgr->poolLatch);
+
+    // Write the victims' dirty pages back; a frame whose write failed holds its old page again
+    for (int i = 0; i < numLoaded; i++) {
+        RC writeResult = finishWriteBack(bufferMgr, loaded[i], &writeBacks[i]);
+        if (writeResult != RC_OK) {
+            resultCode = writeResult;
+            loaded[i] = NULL;
+        }
+    }
+    for (int i = 0; i < numLoaded; ) {
+        if (loaded[i] == NULL) {
+            loaded[i] = loaded[--numLoaded];
+            reservations[i] = reservations[numLoaded];
+        } else {
+            i++;
+        }
+    }
+
+    // Keep the victims' old pages, then copy pages still in the write-behind queue or the
+    // compressed cache from there rather than read them
+    for (int i = 0; i < numLoaded; i++) {
+        fillCompressed(bufferMgr, &reservations[i], loaded[i]->data);
+    }
+    for (int i = 0; i < numLoaded && resultCode == RC_OK; ) {
+        if (takeQueuedPage(bufferMgr, loaded[i]) || takeCompressedPage(bufferMgr, loaded[i])) {
+            completeRead(bufferMgr, loaded[i], RC_OK, false);
+            loaded[i] = loaded[--numLoaded];
+        } else {
+            i++;
+        }
+    }
+
+    // Read in page order so runs of consecutive pages share one seek
+    qsort(loaded, numLoaded, sizeof(Frame *), comparePageOfMiss);
+    while (done < numLoaded) {
+        int runLength = 1;
+        while (done + runLength < numLoaded
+               && loaded[done + runLength]->currpage == loaded[done]->currpage + runLength) {
+            runLength++;
+        }
+
+        RC readResult = resultCode;  // After a failure only release the published frames
+        if (readResult == RC_OK) {
+            for (int i = 0; i < runLength; i++) runData[i] = loaded[done + i]->data;
+            readResult = readBlocks(loaded[done]->currpage, runLength, &fileHandle, runData);
+            resultCode = readResult;
+        }
+        for (int i = 0; i < runLength; i++) {
+            completeRead(bufferMgr, loaded[done + i], readResult, true);
+        }
+        done += runLength;
+    }
+    closePageFile(&fileHandle);
+
+    if (resultCode != RC_OK) {
+        // All or nothing: drop the pins this call took; failed reads already gave theirs up
+        for (int i = 0; i < numMisses; i++) {
+            Frame *frame = pages[missIdx[i]].frameRef;
+            if (frame != NULL && frame->currpage == pages[missIdx[i]].pageNum && frame->fileId == fileId) {
+                releasePin(frame);
+            }
+            pages[missIdx[i]].frameRef = NULL;
+        }
+    }
+
+    free(loaded);
+    free(runData);
+    free(reservations);
+    free(writeBacks);
+    return resultCode;
+}
+
+RC pinPages(BM_BufferPool *const bm, BM_PageHandle *const pages, const PageNumber *pageNums, int n)
+/* Pins n pages of the handle's file in one call, filling pages[i] for pageNums[i].
+   Resident pages are pinned as with pinPage; the misses are loaded together, sorted by page,
+   with consecutive pages read in one storage manager call. Duplicates in pageNums pin the page
+   once per occurrence. On failure no page of the batch stays pinned. */
+{
+    Buffer *bufferMgr = bufferOf(bm);
+    if (bufferMgr == NULL) {
+        return RC_FILE_HANDLE_NOT_INIT;  // Pool not initialised or already shut down
+    }
+    if (n <= 0) return RC_OK;
+
+    for (int i = 0; i < n; i++) {
+        pages[i].frameRef = NULL;  // Until the pin succeeds
+        pages[i].latchMode = BM_LATCH_NONE;
+        if (pageNums[i] < 0) return RC_IM_KEY_NOT_FOUND;
+    }
+
+    int fileId = fileOf(bm);
+    int *missIdx = malloc(n * sizeof(int));
+    int *dupIdx = malloc(n * sizeof(int));
+    int numMisses = 0;
+    int numDups = 0;
+    RC resultCode = RC_OK;
+
+    bool batched = (bufferMgr->strategy == RS_FIFO || bufferMgr->strategy == RS_LRU
+                    || sweptByClock(bufferMgr));
+
+    // No batched loads for the other strategies; pin one page at a time
+    for (int i = 0; i < n && !batched && resultCode == RC_OK; i++) {
+        resultCode = pinPage(bm, &pages[i], pageNums[i]);
+    }
+
+    for (int i = 0; i < n && batched; i++) {
+        tracePin(bufferMgr, fileId, pageNums[i]);  // pinPage traces and samples the others
+        adaptSample(bufferMgr, fileId, pageNums[i]);
+    }
+
+    for (int i = 0; i < n && batched; i++) {
+        pages[i].pageNum = pageNums[i];
+
+        // A page missed earlier in the batch is pinned again once loaded, not read twice
+        int j;
+        for (j = 0; j < numMisses && pageNums[missIdx[j]] != pageNums[i]; j++);
+        if (j < numMisses) {
+            dupIdx[numDups++] = i;
+            continue;
+        }
+
+        Frame *frame = alreadyPinned(bufferMgr, fileId, pageNums[i], NULL);
+        if (frame == NULL) {
+            missIdx[numMisses++] = i;
+            continue;
+        }
+        touchFrame(bufferMgr, frame, false);
+        atomic_fetch_add(&bufferMgr->stats.numHits, 1);
+        pages[i].data = frame->data;
+        pages[i].frameRef = frame;
+    }
+
+    if (numMisses > 0) {
+        resultCode = loadMisses(bufferMgr, fileId, pages, missIdx, numMisses);
+    }
+
+    for (int i = 0; i < numDups && resultCode == RC_OK; i++) {
+        resultCode = pinWithStrategy(bufferMgr, fileId, &pages[dupIdx[i]], pageNums[dupIdx[i]], NULL);
+    }
+
+    if (resultCode != RC_OK) {
+        for (int i = 0; i < n; i++) {
+            if (pages[i].frameRef != NULL) unpinPageRef(bm, &pages[i]);
+        }
+    }
+    free(missIdx);
+    free(dupIdx);
+    return resultCode;
+}
+
+RC unpinPages(BM_BufferPool *const bm, BM_PageHandle *const pages, int n)
+/* Unpins every handle filled by pinPages (or pinPage). Returns the first error, after trying all. */
+{
+    RC resultCode = RC_OK;
+
+    for (int i = 0; i < n; i++) {
+        RC unpinResult = unpinPageRef(bm, &pages[i]);
+        if (resultCode == RC_OK) resultCode = unpinResult;
+    }
+    return resultCode;
+}
+
+/* Page Latches */
+RC latchPage(BM_BufferPool *const bm, BM_PageHandle *const page, BM_LatchMode mode)
+/* Takes the latch of the handle's pinned page: shared for reading, exclusive for changing it.
+   Waits while another handle holds it in a conflicting mode; the pin keeps the page resident
+   meanwhile. While a handle holds it exclusively, optimistic readers fall back to a shared pin.
+   A handle holds at most one latch, and a thread must not latch a page exclusively twice. */
+{
+    Buffer *bufferMgr = bufferOf(bm);
+    if (bufferMgr == NULL) return RC_FILE_HANDLE_NOT_INIT;
+
+    Frame *frame = pinnedFrameOf(bm, page);
+    if (frame == NULL) return RC_READ_NON_EXISTING_PAGE;  // Not pinned through this handle
+    if (page->latchMode != BM_LATCH_NONE || (mode != BM_LATCH_SHARED && mode != BM_LATCH_EXCLUSIVE)) {
+        return RC_INVALID_INPUT;  // Already latched, or not a latch mode
+    }
+
+    int busy = (mode == BM_LATCH_SHARED) ? pthread_rwlock_tryrdlock(&frame->pageLatch)
+                                          : pthread_rwlock_trywrlock(&frame->pageLatch);
+    if (busy != 0) {
+        atomic_fetch_add(&bufferMgr->stats.numLatchWaits, 1);
+        int failed = (mode == BM_LATCH_SHARED) ? pthread_rwlock_rdlock(&frame->pageLatch)
+                                                : pthread_rwlock_wrlock(&frame->pageLatch);
+        if (failed != 0) return RC_INVALID_INPUT;  // The thread already holds it exclusively
+    }
+    if (mode == BM_LATCH_EXCLUSIVE) {
+        atomic_fetch_add(&frame->version, 1);  // Odd while held: optimistic readers back off
+        atomic_thread_fence(memory_order_release);  // ...and whoever sees a changed byte sees it odd
+    }
+    page->latchMode = mode;
+    return RC_OK;
+}
+
+RC unlatchPage(BM_BufferPool *const bm, BM_PageHandle *const page)
+/* Releases the handle's page latch and keeps the pin, e.g. between two calls of a scan. */
+{
+    if (bufferOf(bm) == NULL) return RC_FILE_HANDLE_NOT_INIT;
+
+    Frame *frame = pinnedFrameOf(bm, page);
+    if (frame == NULL) return RC_READ_NON_EXISTING_PAGE;
+    if (page->latchMode == BM_LATCH_NONE) return RC_INVALID_INPUT;
+
+    releaseLatch(frame, page);
+    return RC_OK;
+}
+
+static RC pinLatched(BM_BufferPool *const bm, BM_PageHandle *const page, const PageNumber pageNum,
+                     BM_LatchMode mode)
+/* pinPage followed by latchPage; if the latch cannot be had, the pin is dropped again. */
+{
+    RC resultCode = pinPage(bm, page, pageNum);
+    if (resultCode != RC_OK) return resultCode;
+
+    resultCode = latchPage(bm, page, mode);
+    if (resultCode != RC_OK) unpinPageRef(bm, page);
+    return resultCode;
+}
+
+RC pinPageShared(BM_BufferPool *const bm, BM_PageHandle *const page, const PageNumber pageNum)
+/* Pins the page for reading: any number of shared holders, but no exclusive one, at a time.
+   unpinPage or unpinPageRef release the latch with the pin. */
+{
+    return pinLatched(bm, page, pageNum, BM_LATCH_SHARED);
+}
+
+RC pinPageExclusive(BM_BufferPool *const bm, BM_PageHandle *const page, const PageNumber pageNum)
+/* Pins the page for changing it: waits until no other handle holds its latch. */
+{
+    return pinLatched(bm, page, pageNum, BM_LATCH_EXCLUSIVE);
+}
+
+/* Scratch Pages */
+static bool nextScratchNumber(Buffer *bufferMgr, PageNumber *pageNum)
+/* Takes a page number for a new scratch page, reusing freed ones first. Caller holds the pool latch. */
+{
+    if (bufferMgr->scratch.numFree > 0) {
+        *pageNum = bufferMgr->scratch.freeList[--bufferMgr->scratch.numFree];
+        return true;
+    }
+
+    if (bufferMgr->scratch.end == bufferMgr->scratch.capacity) {
+        int capacity = (bufferMgr->scratch.capacity > 0) ? 2 * bufferMgr->scratch.capacity : 64;
+        unsigned char *state = realloc(bufferMgr->scratch.state, capacity);
+        if (state == NULL) return false;
+        bufferMgr->scratch.state = state;
+        PageNumber *freeList = realloc(bufferMgr->scratch.freeList, sizeof(PageNumber) * capacity);
+        if (freeList == NULL) return false;
+        bufferMgr->scratch.freeList = freeList;
+        bufferMgr->scratch.capacity = capacity;
+    }
+    *pageNum = bufferMgr->scratch.end++;
+    bufferMgr->scratch.state[*pageNum] = SCRATCH_FREE;
+    return true;
+}
+
+RC allocScratchPage(BM_BufferPool *const bm, BM_PageHandle *const page)
+/* Pins a new scratch page filled with zeros, e.g. for a sort run or a hash join partition.
+   Scratch pages belong to the pool, not to a page file: they are replaced like any other page,
+   spilled to an anonymous temp file when evicted dirty, never written by a flush or checkpoint,
+   and discarded by freeScratchPage or with the pool. page->pageNum names the page for
+   pinScratchPage and freeScratchPage. */
+{
+    Buffer *bufferMgr = bufferOf(bm);
+    CacheReservation reservation;
+    WriteBack writeBack;
+    PageNumber pageNum;
+
+    page->frameRef = NULL;  // Until the pin succeeds
+    page->latchMode = BM_LATCH_NONE;
+    if (bufferMgr == NULL) {
+        return RC_FILE_HANDLE_NOT_INIT;
+    }
+
+    latch(bufferMgr, &bufferMgr->poolLatch);
+    if (!nextScratchNumber(bufferMgr, &pageNum)) {
+        unlatch(bufferMgr, &bufferMgr->poolLatch);
+        return RC_MEMORY_ALLOCATION_FAIL;
+    }
+    Frame *victim = selectVictim(bufferMgr);
+    RC resultCode = (victim != NULL) ? RC_OK : RC_IM_NO_MORE_ENTRIES;  // No available frame
+    if (resultCode == RC_OK) {
+        resultCode = evictAndPublish(bufferMgr, victim, SCRATCH_FILE, pageNum, false, &reservation, &writeBack);
+    }
+    if (resultCode != RC_OK) {
+        bufferMgr->scratch.freeList[bufferMgr->scratch.numFree++] = pageNum;
+        unlatch(bufferMgr, &bufferMgr->poolLatch);
+        return resultCode;
+    }
+    bufferMgr->scratch.state[pageNum] = SCRATCH_NEW;
+    bufferMgr->scratch.numPages++;
+    unlatch(bufferMgr, &bufferMgr->poolLatch);
+
+    resultCode = finishWriteBack(bufferMgr, victim, &writeBack);
+    if (resultCode != RC_OK) {
+        latch(bufferMgr, &bufferMgr->poolLatch);
+        bufferMgr->scratch.state[pageNum] = SCRATCH_FREE;
+        bufferMgr->scratch.freeList[bufferMgr->scratch.numFree++] = pageNum;
+        bufferMgr->scratch.numPages--;
+        unlatch(bufferMgr, &bufferMgr->poolLatch);
+        return resultCode;
+    }
+
+    // A new page needs no read, only the victim's page kept and the frame cleared
+    fillCompressed(bufferMgr, &reservation, victim->data);
+    memset(victim->data, 0, PAGE_SIZE);
+    completeRead(bufferMgr, victim, RC_OK, false);
+
+    page->pageNum = pageNum;
+    page->data = victim->data;
+    page->frameRef = victim;
+    return RC_OK;
+}
+
+RC pinScratchPage(BM_BufferPool *const bm, BM_PageHandle *const page, const PageNumber pageNum)
+/* Pins a scratch page allocScratchPage handed out, reading it back from the temp file if it
+   was spilled. Unpin, mark dirty or latch it like any page; forcing it writes nothing.
+   Returns RC_READ_NON_EXISTING_PAGE for a page number that is not allocated. */
+{
+    Buffer *bufferMgr = bufferOf(bm);
+    page->frameRef = NULL;  // Until the pin succeeds
+    page->latchMode = BM_LATCH_NONE;
+    if (bufferMgr == NULL) {
+        return RC_FILE_HANDLE_NOT_INIT;
+    }
+    if (pageNum < 0) {
+        return RC_READ_NON_EXISTING_PAGE;
+    }
+
+    return pinWithStrategy(bufferMgr, SCRATCH_FILE, page, pageNum, NULL);
+}
+
+RC freeScratchPage(BM_BufferPool *const bm, const PageNumber pageNum)
+/* Discards a scratch page: its frame, if it still has one, is emptied without a write, and the
+   page number may be handed out again. Fails with RC_PINNED_PAGES_IN_BUFFER while the page is
+   pinned, and with RC_READ_NON_EXISTING_PAGE if it is not allocated. */
+{
+    Buffer *bufferMgr = bufferOf(bm);
+    if (bufferMgr == NULL) return RC_FILE_HANDLE_NOT_INIT;
+
+    latch(bufferMgr, &bufferMgr->poolLatch);
+    while (pageNum >= 0 && writeBackPending(bufferMgr, SCRATCH_FILE, pageNum)) {
+        // Its spill is still being written; a new owner of the number must not be overwritten by it
+        unlatch(bufferMgr, &bufferMgr->poolLatch);
+        waitForWriteBack(bufferMgr, SCRATCH_FILE, pageNum);
+        latch(bufferMgr, &bufferMgr->poolLatch);
+    }
+    if (pageNum < 0 || pageNum >= bufferMgr->scratch.end || bufferMgr->scratch.state[pageNum] == SCRATCH_FREE) {
+        unlatch(bufferMgr, &bufferMgr->poolLatch);
+        return RC_READ_NON_EXISTING_PAGE;
+    }
+
+    // Pins are taken under the partition latch, so none can start while the frame is emptied
+    int part = partitionOf(bufferMgr, SCRATCH_FILE, pageNum);
+    latch(bufferMgr, &bufferMgr->partLatch[part]);
+    Frame *frame = lookupFrame(bufferMgr, SCRATCH_FILE, pageNum);
+    if (frame != NULL) atomic_fetch_add(&frame->residency, 1);  // As in claimFrame
+    if (frame != NULL && (atomic_load(&frame->fixCount) > 0 || frame->ioInProgress)) {
+        unlatch(bufferMgr, &bufferMgr->partLatch[part]);
+        unlatch(bufferMgr, &bufferMgr->poolLatch);
+        return RC_PINNED_PAGES_IN_BUFFER;
+    }
+    if (frame != NULL) {
+        atomic_fetch_add(&frame->version, 1);
+        removeFrame(bufferMgr, frame);
+        frame->currpage = NO_PAGE;
+        atomic_fetch_add(&frame->version, 1);
+        clearDirty(bufferMgr, frame);  // Dropped, never spilled
+    }
+    unlatch(bufferMgr, &bufferMgr->partLatch[part]);
+
+    bufferMgr->scratch.state[pageNum] = SCRATCH_FREE;
+    bufferMgr->scratch.freeList[bufferMgr->scratch.numFree++] = pageNum;
+    bufferMgr->scratch.numPages--;
+    unlatch(bufferMgr, &bufferMgr->poolLatch);
+    return RC_OK;
+}
+
+/* Statistics report every frame of the pool; frames holding another file's page
+   read as empty through this handle. The I/O and eviction counters are pool-wide.
+   After another handle resized the pool, entries past its current size read as empty. */
+PageNumber *getFrameContents (BM_BufferPool *const bm)
+{
+    // Allocate memory to store the current page numbers for all frames
+    PageNumber *frameContents = calloc(bm->numPages, sizeof(int));
+
+    // Access buffer metadata and the head of the statistics list
+    Buffer *bufferInfo = bufferOf(bm);
+    int fileId = fileOf(bm);
+    statlist *currentStatNode;
+
+    // Iterate through the list to populate the frame contents
+    latch(bufferInfo, &bufferInfo->poolLatch);
+    currentStatNode = bufferInfo->stathead;
+    for (int pageIndex = 0; pageIndex < bm->numPages; pageIndex++)
+    {
+        Frame *frame = (currentStatNode != NULL) ? currentStatNode->fpt : NULL;
+        frameContents[pageIndex] = (frame != NULL && frame->fileId == fileId) ? frame->currpage : NO_PAGE;
+        if (currentStatNode != NULL) currentStatNode = currentStatNode->next;
+    }
+    unlatch(bufferInfo, &bufferInfo->poolLatch);
+
+    // Return the array with the frame contents
+    return frameContents;
+}
+
+bool *getDirtyFlags (BM_BufferPool *const bm)
+{
+    // Allocate memory for storing dirty flags for all pages
+    bool *dirtyFlagArray = calloc(bm->numPages, sizeof(bool));
+
+    // Retrieve buffer metadata and the statistics list
+    Buffer *bufferInfo = bufferOf(bm);
+    int fileId = fileOf(bm);
+    statlist *currentStatNode;
+
+    // Iterate over the pages to populate the dirty flags
+    latch(bufferInfo, &bufferInfo->poolLatch);
+    currentStatNode = bufferInfo->stathead;
+    for (int pageIndex = 0; pageIndex < bm->numPages && currentStatNode != NULL; pageIndex++)
+    {
+        if (currentStatNode->fpt->dirty && currentStatNode->fpt->fileId == fileId)
+        {
+            dirtyFlagArray[pageIndex] = true;
+        }
+        currentStatNode = currentStatNode->next;
+    }
+    unlatch(bufferInfo, &bufferInfo->poolLatch);
+
+    // Return the array containing the dirty flags
+    return dirtyFlagArray;
+}
+
+int *getFixCounts (BM_BufferPool *const bm)
+{
+    // Allocate memory to store fix counts for all pages
+    PageNumber *fixCountArray = calloc(bm->numPages, sizeof(int));
+
+    // Retrieve the buffer and statistics list
+    Buffer *bufferMetadata = bufferOf(bm);
+    int fileId = fileOf(bm);
+    statlist *currentStat;
+
+    // Iterate through pages to extract fix counts
+    latch(bufferMetadata, &bufferMetadata->poolLatch);
+    currentStat = bufferMetadata->stathead;
+    for (int pageIndex = 0; pageIndex < bm->numPages && currentStat != NULL; pageIndex++)
+    {
+        if (currentStat->fpt->fileId == fileId)
+        {
+            fixCountArray[pageIndex] = atomic_load(&currentStat->fpt->fixCount);
+        }
+        currentStat = currentStat->next;
+    }
+    unlatch(bufferMetadata, &bufferMetadata->poolLatch);
+
+    // Return the populated fix count array
+    return fixCountArray;
+}
+
+int getNumReadIO (BM_BufferPool *const bufferPool)
+{
+    // Access the buffer metadata
+    Buffer *bufferManager = bufferOf(bufferPool);
+
+    // Retrieve and return the read I/O count
+    return atomic_load(&bufferManager->numRead);
+}
+
+int getNumWriteIO (BM_BufferPool *const bufferPool)
+{
+    // Extract the buffer manager metadata
+    Buffer *bufferManagerData = bufferOf(bufferPool);
+
+    // Return the number of write operations
+    return atomic_load(&bufferManagerData->numWrite);
+}
+
+int getNumEvictions (BM_BufferPool *const bm)
+{
+    Buffer *bufferMgr = bufferOf(bm);
+    return atomic_load(&bufferMgr->stats.numEvictions);
+}
+
+int getNumCleanEvictions (BM_BufferPool *const bm)
+{
+    // Evictions whose victim was already clean, i.e. that did not wait for a write
+    Buffer *bufferMgr = bufferOf(bm);
+    return atomic_load(&bufferMgr->stats.numCleanEvictions);
+}
+
+int getNumBackgroundWrites (BM_BufferPool *const bm)
+{
+    Buffer *bufferMgr = bufferOf(bm);
+    return atomic_load(&bufferMgr->writer.numWrites);
+}
+
+int getNumPrefetches (BM_BufferPool *const bm)
+{
+    Buffer *bufferMgr = bufferOf(bm);
+    return atomic_load(&bufferMgr->prefetch.numPrefetches);
+}
+
+int getNumPrefetchHits (BM_BufferPool *const bm)
+{
+    // Prefetched pages that were pinned before being evicted
+    Buffer *bufferMgr = bufferOf(bm);
+    return atomic_load(&bufferMgr->prefetch.numHits);
+}
+
+int getNumPrefetchWasted (BM_BufferPool *const bm)
+{
+    // Prefetched pages evicted without ever being pinned
+    Buffer *bufferMgr = bufferOf(bm);
+    return atomic_load(&bufferMgr->prefetch.numWasted);
+}
+
+void getPoolStats (BM_BufferPool *const bm, BM_PoolStats *const stats)
+/* Copies the pool's counters into the caller's struct without allocating. Each counter is read
+   atomically, but pins running meanwhile can make them slightly inconsistent with each other. */
+{
+    Buffer *bufferMgr = bufferOf(bm);
+    memset(stats, 0, sizeof(BM_PoolStats));
+    if (bufferMgr == NULL) return;
+
+    stats->strategy = bufferMgr->strategy;
+    stats->numFrames = bufferMgr->numFrames;
+    stats->hits = atomic_load(&bufferMgr->stats.numHits);
+    stats->misses = atomic_load(&bufferMgr->stats.numMisses);
+    stats->pinWaits = atomic_load(&bufferMgr->stats.numPinWaits);
+    stats->readIO = atomic_load(&bufferMgr->numRead);
+    stats->writeIO = atomic_load(&bufferMgr->numWrite);
+    stats->evictions = atomic_load(&bufferMgr->stats.numEvictions);
+    stats->dirtyEvictions = stats->evictions - atomic_load(&bufferMgr->stats.numCleanEvictions);
+    stats->victimSearches = atomic_load(&bufferMgr->stats.numSearches);
+    stats->victimSearchSteps = atomic_load(&bufferMgr->stats.numSearchSteps);
+    stats->optimisticReads = atomic_load(&bufferMgr->stats.numOptimisticReads);
+    stats->optimisticFallbacks = atomic_load(&bufferMgr->stats.numOptimisticFallbacks);
+    stats->strategySwitches = atomic_load(&bufferMgr->adapt.numSwitches);
+    stats->queuedWrites = atomic_load(&bufferMgr->wb.numQueuedWrites);
+    stats->queueHits = atomic_load(&bufferMgr->wb.numQueueHits);
+    stats->latchWaits = atomic_load(&bufferMgr->stats.numLatchWaits);
+    stats->pinCacheHits = atomic_load(&bufferMgr->stats.numPinCacheHits);
+    stats->compressedStores = atomic_load(&bufferMgr->cc.numStores);
+    stats->compressedHits = atomic_load(&bufferMgr->cc.numHits);
+    stats->compressedDrops = atomic_load(&bufferMgr->cc.numDrops);
+    latch(bufferMgr, &bufferMgr->poolLatch);
+    stats->scratchPages = bufferMgr->scratch.numPages;
+    unlatch(bufferMgr, &bufferMgr->poolLatch);
+    stats->scratchSpills = atomic_load(&bufferMgr->scratch.numSpills);
+    stats->ghostHits = atomic_load(&bufferMgr->governor.numGhostHits);
+    latch(bufferMgr, &bufferMgr->cc.latch);
+    stats->compressedBytes = bufferMgr->cc.bytes;
+    unlatch(bufferMgr, &bufferMgr->cc.latch);
+    stats->arenaBytes = bufferMgr->arena.bytes;
+    stats->hugePageBytes = bufferMgr->arena.hugePageBytes;
+    for (int i = 0; i < BM_SEARCH_BUCKETS; i++) {
+        stats->searchLength[i] = atomic_load(&bufferMgr->stats.searchLength[i]);
+    }
+    for (int i = 0; i < BM_LATENCY_BUCKETS; i++) {
+        stats->hitLatency[i] = atomic_load(&bufferMgr->stats.hitLatency[i]);
+        stats->missLatency[i] = atomic_load(&bufferMgr->stats.missLatency[i]);
+    }
+}
@@ -1,67 +1,225 @@
-#ifndef BUFFER_MANAGER_H
-#define BUFFER_MANAGER_H
-
-// Include return codes and methods for logging errors
-#include "dberror.h"
-#include "storage_mgr.h"
-// Include bool DT
-#include "dt.h"
-
-// Replacement Strategies
-typedef enum ReplacementStrategy
-{
-    RS_FIFO = 0,
-    RS_LRU = 1,
-    RS_CLOCK = 2,
-    RS_LFU = 3,
-    RS_LRU_K = 4
-} ReplacementStrategy;
-
-// Data Types and Structures
-typedef int PageNumber;
-#define NO_PAGE -1
-
-typedef struct BM_BufferPool
-{
-    char *pageFile;
-    int numPages;
-    ReplacementStrategy strategy;
-    void *mgmtData; // use this one to store the bookkeeping info your buffer
-                    // manager needs for a buffer pool
-} BM_BufferPool;
-
-typedef struct BM_PageHandle
-{
-    PageNumber pageNum;
-    char *data;
-} BM_PageHandle;
-
-// convenience macros
-#define MAKE_POOL() \
-    ((BM_BufferPool *)malloc(sizeof(BM_BufferPool)))
-
-#define MAKE_PAGE_HANDLE() \
-    ((BM_PageHandle *)malloc(sizeof(BM_PageHandle)))
-
-// Buffer Manager Interface Pool Handling
-RC initBufferPool(BM_BufferPool *const bm, const char *const pageFileName,
-                  const int numPages, ReplacementStrategy strategy,
-                  void *stratData);
-RC shutdownBufferPool(BM_BufferPool *const bm);
-RC forceFlushPool(BM_BufferPool *const bm);
-
-// Buffer Manager Interface Access Pages
-RC markDirty(BM_BufferPool *const bm, BM_PageHandle *const page);
-RC unpinPage(BM_BufferPool *const bm, BM_PageHandle *const page);
-RC forcePage(BM_BufferPool *const bm, BM_PageHandle *const page);
-RC pinPage(BM_BufferPool *const bm, BM_PageHandle *const page,
-           const PageNumber pageNum);
-
-// Statistics Interface
-PageNumber *getFrameContents(BM_BufferPool *const bm);
-bool *getDirtyFlags(BM_BufferPool *const bm);
-int *getFixCounts(BM_BufferPool *const bm);
-int getNumReadIO(BM_BufferPool *const bm);
-int getNumWriteIO(BM_BufferPool *const bm);
-
-#endif
+#ifndef BUFFER_MANAGER_H
+#define BUFFER_MANAGER_H
+
+// Include return codes and methods for logging errors
+#include "dberror.h"
+#include "storage_mgr.h"
+// Include bool DT
+#include "dt.h"
+
+// Replacement Strategies
+typedef enum ReplacementStrategy
+{
+    RS_FIFO = 0,
+    RS_LRU = 1,
+    RS_CLOCK = 2,
+    RS_LFU = 3,
+    RS_LRU_K = 4,
+    RS_GCLOCK = 5 // CLOCK with per-frame usage counters instead of a reference bit
+} ReplacementStrategy;
+
+// Data Types and Structures
+typedef int PageNumber;
+#define NO_PAGE -1
+#define SHARED_POOL_DEFAULT_PAGES 128 // frames of the shared pool when attachBufferPool has to create it
+#define HOT_PAGES_SUFFIX ".hot" // appended to the page file name for its saved hot-page list
+#define GCLOCK_MAX_USAGE 5 // GCLOCK usage counter ceiling: sweeps of the clock hand an unused page survives at most
+#define GOVERNOR_STEP_PAGES 32 // frames rebalancePools moves at most, and the evicted pages each pool remembers to measure its gain
+#define GOVERNOR_MIN_PAGES 8 // default setPoolMinimum (or the pool's size if it is smaller)
+
+typedef struct BM_BufferPool
+{
+    char *pageFile;
+    int numPages;
+    ReplacementStrategy strategy;
+    void *mgmtData; // use this one to store the bookkeeping info your buffer
+                    // manager needs for a buffer pool
+} BM_BufferPool;
+
+// Optional pool features; fill with initPoolOptions and override what you need
+typedef struct BM_PoolOptions
+{
+    bool threadSafe; // latch the page table and frame list so many threads can pin concurrently
+    bool backgroundWriter; // flush dirty unpinned frames ahead of eviction (implies threadSafe)
+    int bgWriterDelayMs; // background writer sleep between rounds
+    int bgWriterMaxPages; // pages written per round at most
+    double bgWriterLowWater; // start writing when fewer than this fraction of unpinned frames are clean
+    double bgWriterHighWater; // keep writing until this fraction is clean
+    bool asyncPrefetch; // serve prefetchPages from a prefetch thread (implies threadSafe)
+    bool saveHotPages; // write each file's resident pages, hottest first, to <file>.hot on its last shutdown
+    int hotPagesIntervalMs; // with saveHotPages, also rewrite the lists this often (0: only on shutdown)
+    bool preloadHotPages; // read the pages listed in <file>.hot when a file is attached
+    bool hugePages; // map frame memory 2 MB-aligned and advise transparent huge pages (frame runs of 2 MB and more); off by default
+    bool hugeTlb; // with hugePages, try MAP_HUGETLB pages first; needs huge pages reserved by the admin
+    bool writeBehind; // copy dirty victims to a queue written in batches, so misses do not wait for the write (implies threadSafe)
+    int writeBehindPages; // pages the write-behind queue holds, including the batch being written
+    bool adaptiveStrategy; // replay sampled pins against FIFO, LRU, CLOCK and GCLOCK and switch to whichever clearly hits more
+    int adaptWindowPins; // sampled pins between two adaptive decisions
+    bool compressedCache; // keep clean victims compressed in memory and check them before reading a page from disk
+    int compressedCacheBytes; // memory the compressed cache may use, entries included
+    bool pinCache; // each thread remembers its last few pins and re-pins those pages without the page table and its latch
+} BM_PoolOptions;
+
+// Private ring of frames for a scan, bulk load or index build (see pinPageWithRing)
+typedef struct BM_AccessRing BM_AccessRing;
+
+#define BM_LATENCY_BUCKETS 16 // pin latency histogram: bucket 0 is <1us, bucket i is [2^(i-1), 2^i) us, the last is open-ended
+#define BM_SEARCH_BUCKETS 12 // victim search histogram: bucket 0 is 1 frame examined, bucket i is (2^(i-1), 2^i], the last is open-ended
+
+// Position of one scan in the group of scans sharing a file (see startSyncScan)
+typedef struct BM_SyncScan BM_SyncScan;
+
+// Counters of one pool since it was created, filled by getPoolStats
+typedef struct BM_PoolStats
+{
+    ReplacementStrategy strategy; // the live strategy; the search lengths below are for whichever strategy was live at the time
+    long strategySwitches; // strategy changes made by adaptiveStrategy
+    int numFrames;
+    long hits; // pins served from a resident frame
+    long misses; // pins that read the page in
+    long pinWaits; // pins that waited for another thread's read of the same page
+    long pinCacheHits; // pins served by the pinning thread's pin cache, without a page table lookup
+    long readIO;
+    long writeIO;
+    long evictions; // misses that replaced a resident page
+    long dirtyEvictions; // ...of which the victim had to be written first
+    long victimSearches; // strategy victim searches (not counting access rings and stale prefetches)
+    long victimSearchSteps; // frames examined by those searches
+    long optimisticReads; // readPageOptimistic calls served without a pin
+    long optimisticFallbacks; // ...that fell back to a pin
+    long queuedWrites; // dirty victims handed to the write-behind queue
+    long queueHits; // misses served from the write-behind queue without a read
+    long latchWaits; // page latch requests that had to wait for another holder
+    long compressedStores; // clean victims stored in the compressed cache
+    long compressedHits; // misses served from the compressed cache without a read
+    long compressedDrops; // entries dropped, oldest first, to stay within compressedCacheBytes
+    long compressedBytes; // memory the compressed cache uses now
+    long scratchPages; // scratch pages allocated now
+    long scratchSpills; // scratch pages written to the pool's temp file
+    long ghostHits; // misses on a page among the last GOVERNOR_STEP_PAGES evicted (see rebalancePools)
+    long arenaBytes; // memory mapped for frame data
+    long hugePageBytes; // ...of which advised for or mapped with huge pages
+    long searchLength[BM_SEARCH_BUCKETS];
+    long hitLatency[BM_LATENCY_BUCKETS]; // single-page pins only
+    long missLatency[BM_LATENCY_BUCKETS];
+} BM_PoolStats;
+
+// Pin trace file (startPinTrace): a BM_TraceHeader, then one BM_TraceRecord per pinned page,
+// both in host byte order
+#define PIN_TRACE_MAGIC 0x52544D42 // "BMTR" on little-endian hosts
+#define PIN_TRACE_VERSION 1
+
+typedef struct BM_TraceHeader
+{
+    int magic;
+    int version;
+    int recordSize; // sizeof(BM_TraceRecord)
+} BM_TraceHeader;
+
+typedef struct BM_TraceRecord
+{
+    int fileId; // registry slot of the page file in the traced pool
+    PageNumber pageNum;
+    unsigned int deltaMicros; // time since the previous record, saturating
+} BM_TraceRecord;
+
+// Page latch a handle holds on its pinned page (see pinPageShared)
+typedef enum BM_LatchMode
+{
+    BM_LATCH_NONE = 0,
+    BM_LATCH_SHARED = 1, // readers; any number at once
+    BM_LATCH_EXCLUSIVE = 2 // one writer, no readers
+} BM_LatchMode;
+
+typedef struct BM_PageHandle
+{
+    PageNumber pageNum;
+    char *data;
+    void *frameRef; // frame holding the page, set by pinPage; used by the *Ref calls
+    BM_LatchMode latchMode; // set by the pin calls; unpinning releases the latch
+} BM_PageHandle;
+
+// convenience macros
+#define MAKE_POOL() \
+    ((BM_BufferPool *)malloc(sizeof(BM_BufferPool)))
+
+#define MAKE_PAGE_HANDLE() \
+    ((BM_PageHandle *)malloc(sizeof(BM_PageHandle)))
+
+// Buffer Manager Interface Pool Handling
+RC initBufferPool(BM_BufferPool *const bm, const char *const pageFileName,
+                  const int numPages, ReplacementStrategy strategy,
+                  void *stratData);
+void initPoolOptions(BM_PoolOptions *const opts);
+RC initBufferPoolWithOptions(BM_BufferPool *const bm, const char *const pageFileName,
+                  const int numPages, ReplacementStrategy strategy,
+                  void *stratData, const BM_PoolOptions *const opts);
+RC initSharedBufferPool(const int numPages, ReplacementStrategy strategy,
+                  const BM_PoolOptions *const opts);
+RC shutdownSharedBufferPool(void);
+RC attachBufferPool(BM_BufferPool *const bm, const char *const pageFileName);
+RC shutdownBufferPool(BM_BufferPool *const bm);
+RC forceFlushPool(BM_BufferPool *const bm);
+RC checkpointPool(BM_BufferPool *const bm, const int pagesPerStep, const int pauseMs);
+RC resizeBufferPool(BM_BufferPool *const bm, const int newNumPages);
+RC saveHotPageList(BM_BufferPool *const bm);
+RC startPinTrace(BM_BufferPool *const bm, const char *const traceFileName);
+RC stopPinTrace(BM_BufferPool *const bm);
+
+// Memory Governor: one frame budget shared by every pool in the process
+RC setMemoryBudget(const long totalBytes);
+RC setPoolMinimum(BM_BufferPool *const bm, const int minPages);
+RC rebalancePools(void);
+
+// Buffer Manager Interface Access Pages
+RC markDirty(BM_BufferPool *const bm, BM_PageHandle *const page);
+RC unpinPage(BM_BufferPool *const bm, BM_PageHandle *const page);
+RC forcePage(BM_BufferPool *const bm, BM_PageHandle *const page);
+RC pinPage(BM_BufferPool *const bm, BM_PageHandle *const page,
+           const PageNumber pageNum);
+RC unpinPageRef(BM_BufferPool *const bm, BM_PageHandle *const page);
+RC markDirtyRef(BM_BufferPool *const bm, BM_PageHandle *const page);
+RC forcePageRef(BM_BufferPool *const bm, BM_PageHandle *const page);
+RC prefetchPages(BM_BufferPool *const bm, const PageNumber *pageNums, int n);
+BM_AccessRing *createAccessRing(int numFrames);
+void freeAccessRing(BM_AccessRing *ring);
+RC pinPageWithRing(BM_BufferPool *const bm, BM_PageHandle *const page,
+           const PageNumber pageNum, BM_AccessRing *ring);
+RC prefetchPagesWithRing(BM_BufferPool *const bm, const PageNumber *pageNums, int n,
+           BM_AccessRing *ring);
+BM_SyncScan *startSyncScan(BM_BufferPool *const bm, const PageNumber firstPage,
+           const PageNumber endPage);
+PageNumber nextSyncScanPage(BM_SyncScan *scan);
+int peekSyncScanPages(const BM_SyncScan *scan, PageNumber *pageNums, int n);
+void endSyncScan(BM_SyncScan *scan);
+RC readPageOptimistic(BM_BufferPool *const bm, const PageNumber pageNum, char *dest,
+           const int offset, const int length);
+RC pinPages(BM_BufferPool *const bm, BM_PageHandle *const pages,
+           const PageNumber *pageNums, int n);
+RC unpinPages(BM_BufferPool *const bm, BM_PageHandle *const pages, int n);
+RC pinPageShared(BM_BufferPool *const bm, BM_PageHandle *const page,
+           const PageNumber pageNum);
+RC pinPageExclusive(BM_BufferPool *const bm, BM_PageHandle *const page,
+           const PageNumber pageNum);
+RC latchPage(BM_BufferPool *const bm, BM_PageHandle *const page, BM_LatchMode mode);
+RC unlatchPage(BM_BufferPool *const bm, BM_PageHandle *const page);
+RC allocScratchPage(BM_BufferPool *const bm, BM_PageHandle *const page);
+RC pinScratchPage(BM_BufferPool *const bm, BM_PageHandle *const page,
+           const PageNumber pageNum);
+RC freeScratchPage(BM_BufferPool *const bm, const PageNumber pageNum);
+
+// Statistics Interface
+PageNumber *getFrameContents(BM_BufferPool *const bm);
+bool *getDirtyFlags(BM_BufferPool *const bm);
+int *getFixCounts(BM_BufferPool *const bm);
+int getNumReadIO(BM_BufferPool *const bm);
+int getNumWriteIO(BM_BufferPool *const bm);
+int getNumEvictions(BM_BufferPool *const bm);
+int getNumCleanEvictions(BM_BufferPool *const bm);
+int getNumBackgroundWrites(BM_BufferPool *const bm);
+int getNumPrefetches(BM_BufferPool *const bm);
+int getNumPrefetchHits(BM_BufferPool *const bm);
+int getNumPrefetchWasted(BM_BufferPool *const bm);
+void getPoolStats(BM_BufferPool *const bm, BM_PoolStats *const stats);
+
+#endif
@@ -6,6 +6,8 @@
 
 // local functions
 static void printStrat (BM_BufferPool *const bm);
+static const char *stratName (ReplacementStrategy strategy);
+static int sprintHistogram (char *message, const long *buckets, int numBuckets, bool json);
 
 // external functions
 void 
@@ -78,6 +80,119 @@ sprintPageContent (BM_PageHandle *const page)
 	return message;
 }
 
+void
+printPoolStats (BM_BufferPool *const bm)
+{
+	char *message = sprintPoolStats(bm, FALSE);
+
+	printf("%s", message);
+	free(message);
+}
+
+// text (one counter per line) or one JSON object; histograms list their buckets in order
+char *
+sprintPoolStats (BM_BufferPool *const bm, bool json)
+{
+	BM_PoolStats stats;
+	char *message;
+	int pos = 0;
+	long pins;
+
+	getPoolStats(bm, &stats);
+	pins = stats.hits + stats.misses;
+	message = (char *) malloc(1536 + 24 * (BM_SEARCH_BUCKETS + 2 * BM_LATENCY_BUCKETS));
+
+	if (json)
+	{
+		pos += sprintf(message + pos, "{\"strategy\":\"%s\",\"strategySwitches\":%ld,\"frames\":%i,\"hits\":%ld,\"misses\":%ld,\"hitRatio\":%.4f,"
+				"\"pinWaits\":%ld,\"pinCacheHits\":%ld,\"readIO\":%ld,\"writeIO\":%ld,\"evictions\":%ld,\"dirtyEvictions\":%ld,"
+				"\"victimSearches\":%ld,\"victimSearchSteps\":%ld,\"optimisticReads\":%ld,\"optimisticFallbacks\":%ld,"
+				"\"queuedWrites\":%ld,\"queueHits\":%ld,\"latchWaits\":%ld,\"compressedStores\":%ld,\"compressedHits\":%ld,"
+				"\"compressedDrops\":%ld,\"compressedBytes\":%ld,\"scratchPages\":%ld,\"scratchSpills\":%ld,\"ghostHits\":%ld,"
+				"\"arenaBytes\":%ld,\"hugePageBytes\":%ld,"
+				"\"searchLength\":",
+				stratName(stats.strategy), stats.strategySwitches, stats.numFrames, stats.hits, stats.misses,
+				pins ? (double) stats.hits / pins : 0.0, stats.pinWaits, stats.pinCacheHits, stats.readIO, stats.writeIO,
+				stats.evictions, stats.dirtyEvictions, stats.victimSearches, stats.victimSearchSteps,
+				stats.optimisticReads, stats.optimisticFallbacks, stats.queuedWrites, stats.queueHits,
+				stats.latchWaits, stats.compressedStores, stats.compressedHits, stats.compressedDrops, stats.compressedBytes,
+				stats.scratchPages, stats.scratchSpills, stats.ghostHits, stats.arenaBytes, stats.hugePageBytes);
+		pos += sprintHistogram(message + pos, stats.searchLength, BM_SEARCH_BUCKETS, json);
+		pos += sprintf(message + pos, ",\"hitLatencyUs\":");
+		pos += sprintHistogram(message + pos, stats.hitLatency, BM_LATENCY_BUCKETS, json);
+		pos += sprintf(message + pos, ",\"missLatencyUs\":");
+		pos += sprintHistogram(message + pos, stats.missLatency, BM_LATENCY_BUCKETS, json);
+		sprintf(message + pos, "}\n");
+		return message;
+	}
+
+	pos += sprintf(message + pos, "{%s %i}\n", stratName(stats.strategy), stats.numFrames);
+	if (stats.strategySwitches > 0)
+		pos += sprintf(message + pos, "strategy switches %ld\n", stats.strategySwitches);
+	pos += sprintf(message + pos, "hits %ld misses %ld hit ratio %.2f%%\n", stats.hits, stats.misses,
+			pins ? 100.0 * stats.hits / pins : 0.0);
+	pos += sprintf(message + pos, "pin waits %ld latch waits %ld pin cache hits %ld\n", stats.pinWaits, stats.latchWaits,
+			stats.pinCacheHits);
+	pos += sprintf(message + pos, "read IO %ld write IO %ld\n", stats.readIO, stats.writeIO);
+	pos += sprintf(message + pos, "evictions %ld dirty %ld\n", stats.evictions, stats.dirtyEvictions);
+	pos += sprintf(message + pos, "victim searches %ld avg length %.2f\n", stats.victimSearches,
+			stats.victimSearches ? (double) stats.victimSearchSteps / stats.victimSearches : 0.0);
+	pos += sprintf(message + pos, "optimistic reads %ld fallbacks %ld\n", stats.optimisticReads, stats.optimisticFallbacks);
+	pos += sprintf(message + pos, "write-behind queued %ld served from queue %ld\n", stats.queuedWrites, stats.queueHits);
+	pos += sprintf(message + pos, "compressed cache stored %ld served %ld dropped %ld, %ld bytes\n", stats.compressedStores,
+			stats.compressedHits, stats.compressedDrops, stats.compressedBytes);
+	pos += sprintf(message + pos, "scratch pages %ld spilled %ld\n", stats.scratchPages, stats.scratchSpills);
+		pos += sprintf(message + pos, "ghost hits %ld\n", stats.ghostHits);
+	pos += sprintf(message + pos, "frame memory %ld bytes, %ld on huge pages\n", stats.arenaBytes, stats.hugePageBytes);
+	pos += sprintf(message + pos, "search length (1,2,4,..):");
+	pos += sprintHistogram(message + pos, stats.searchLength, BM_SEARCH_BUCKETS, json);
+	pos += sprintf(message + pos, "\nhit latency us (<1,<2,<4,..):");
+	pos += sprintHistogram(message + pos, stats.hitLatency, BM_LATENCY_BUCKETS, json);
+	pos += sprintf(message + pos, "\nmiss latency us (<1,<2,<4,..):");
+	pos += sprintHistogram(message + pos, stats.missLatency, BM_LATENCY_BUCKETS, json);
+	sprintf(message + pos, "\n");
+
+	return message;
+}
+
+int
+sprintHistogram (char *message, const long *buckets, int numBuckets, bool json)
+{
+	int pos = 0;
+	int i;
+
+	if (json)
+		pos += sprintf(message + pos, "[");
+	for (i = 0; i < numBuckets; i++)
+		pos += sprintf(message + pos, json ? "%s%ld" : "%s %ld", (json && i > 0) ? "," : "", buckets[i]);
+	if (json)
+		pos += sprintf(message + pos, "]");
+
+	return pos;
+}
+
+const char *
+stratName (ReplacementStrategy strategy)
+{
+	switch (strategy)
+	{
+	case RS_FIFO:
+		return "FIFO";
+	case RS_LRU:
+		return "LRU";
+	case RS_CLOCK:
+		return "CLOCK";
+	case RS_LFU:
+		return "LFU";
+	case RS_LRU_K:
+		return "LRU-K";
+	case RS_GCLOCK:
+		return "GCLOCK";
+	default:
+		return "UNKNOWN";
+	}
+}
+
 void
 printStrat (BM_BufferPool *const bm)
 {
@@ -98,6 +213,9 @@ printStrat (BM_BufferPool *const bm)
 	case RS_LRU_K:
 		printf("LRU-K");
 		break;
+	case RS_GCLOCK:
+		printf("GCLOCK");
+		break;
 	default:
 		printf("%i", bm->strategy);
 		break;
@@ -0,0 +1,252 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "dberror.h"
+#include "storage_mgr.h"
+#include "buffer_mgr.h"
+
+/* Replacement policy simulator.
+   Replays a pin trace written by startPinTrace against each strategy buffer_mgr.c implements,
+   and against the adaptive mode starting from LRU (column ADAPT), at several pool sizes, and
+   prints the hit ratio of every combination. The trace is replayed
+   through the real buffer manager on scratch page files (one per page file in the trace), so
+   the numbers come from the same replacement code the pool runs. Each pin is unpinned right
+   away, since traces do not record unpins.
+
+   usage: simulate_trace <trace file> [pool size ...]
+   Without sizes, the pool doubles from 8 frames up to the number of distinct pages. */
+
+#define SIM_FILE_PATTERN "simtrace%d.bin"
+#define SIM_MAX_SIZES 32
+
+typedef struct SimStrategy
+{
+  ReplacementStrategy strategy;
+  char *name;
+  bool adaptive; // start with strategy and let adaptiveStrategy switch
+} SimStrategy;
+
+// strategies with a replacement implementation in buffer_mgr.c, and the adaptive mode
+static SimStrategy strategies[] = {
+  {RS_FIFO, "FIFO", FALSE},
+  {RS_LRU, "LRU", FALSE},
+  {RS_CLOCK, "CLOCK", FALSE},
+  {RS_GCLOCK, "GCLOCK", FALSE},
+  {RS_LRU, "ADAPT", TRUE},
+};
+#define NUM_STRATEGIES ((int) (sizeof(strategies) / sizeof(strategies[0])))
+
+// helper methods
+static BM_TraceRecord *readTrace (char *fileName, int *numRecords);
+static int countDistinctPages (BM_TraceRecord *records, int numRecords);
+static int compareKeys (const void *a, const void *b);
+static int createScratchFiles (BM_TraceRecord *records, int numRecords);
+static double replay (BM_TraceRecord *records, int numRecords, int numFiles,
+                      SimStrategy *strategy, int poolSize);
+
+// ************************************************************
+int
+main (int argc, char **argv)
+{
+  BM_TraceRecord *records;
+  int numRecords, numFiles, distinct;
+  int sizes[SIM_MAX_SIZES];
+  int numSizes = 0;
+  int i, s;
+
+  if (argc < 2)
+    {
+      fprintf(stderr, "usage: %s <trace file> [pool size ...]\n", argv[0]);
+      return 1;
+    }
+
+  records = readTrace(argv[1], &numRecords);
+  if (records == NULL)
+    return 1;
+  if (numRecords == 0)
+    {
+      printf("empty trace\n");
+      free(records);
+      return 0;
+    }
+  distinct = countDistinctPages(records, numRecords);
+
+  for (i = 2; i < argc && numSizes < SIM_MAX_SIZES; i++)
+    if (atoi(argv[i]) > 0)
+      sizes[numSizes++] = atoi(argv[i]);
+  if (numSizes == 0)
+    {
+      for (s = 8; s < distinct && numSizes < SIM_MAX_SIZES - 1; s *= 2)
+        sizes[numSizes++] = s;
+      sizes[numSizes++] = distinct;
+    }
+
+  initStorageManager();
+  numFiles = createScratchFiles(records, numRecords);
+
+  printf("trace: %d pins, %d distinct pages, %d files\n", numRecords, distinct, numFiles);
+  printf("%8s", "frames");
+  for (i = 0; i < NUM_STRATEGIES; i++)
+    printf(" %8s", strategies[i].name);
+  printf("\n");
+
+  for (s = 0; s < numSizes; s++)
+    {
+      printf("%8d", sizes[s]);
+      for (i = 0; i < NUM_STRATEGIES; i++)
+        printf(" %7.2f%%", 100.0 * replay(records, numRecords, numFiles, &strategies[i], sizes[s]));
+      printf("\n");
+    }
+
+  for (i = 0; i < numFiles; i++)
+    {
+      char fileName[64];
+
+      sprintf(fileName, SIM_FILE_PATTERN, i);
+      destroyPageFile(fileName);
+    }
+  free(records);
+  return 0;
+}
+
+// ************************************************************
+BM_TraceRecord *
+readTrace (char *fileName, int *numRecords)
+{
+  FILE *file = fopen(fileName, "rb");
+  BM_TraceHeader header;
+  BM_TraceRecord *records = NULL;
+  int capacity = 0;
+
+  *numRecords = 0;
+  if (file == NULL)
+    {
+      fprintf(stderr, "cannot open %s\n", fileName);
+      return NULL;
+    }
+  if (fread(&header, sizeof(header), 1, file) != 1 || header.magic != PIN_TRACE_MAGIC
+      || header.version != PIN_TRACE_VERSION || header.recordSize != (int) sizeof(BM_TraceRecord))
+    {
+      fprintf(stderr, "%s is not a pin trace of this version\n", fileName);
+      fclose(file);
+      return NULL;
+    }
+
+  for (;;)
+    {
+      if (*numRecords == capacity)
+        {
+          capacity = capacity ? capacity * 2 : 4096;
+          records = realloc(records, sizeof(BM_TraceRecord) * capacity);
+        }
+      if (fread(&records[*numRecords], sizeof(BM_TraceRecord), 1, file) != 1)
+        break;
+      if (records[*numRecords].fileId < 0 || records[*numRecords].pageNum < 0)
+        continue;  // not a page the pool could have pinned
+      (*numRecords)++;
+    }
+
+  fclose(file);
+  return records;
+}
+
+// ************************************************************
+int
+countDistinctPages (BM_TraceRecord *records, int numRecords)
+{
+  long long *keys = malloc(sizeof(long long) * numRecords);
+  int distinct = 0;
+  int i;
+
+  for (i = 0; i < numRecords; i++)
+    keys[i] = ((long long) records[i].fileId << 32) | (unsigned int) records[i].pageNum;
+  qsort(keys, numRecords, sizeof(long long), compareKeys);
+  for (i = 0; i < numRecords; i++)
+    distinct += (i == 0 || keys[i] != keys[i - 1]);
+
+  free(keys);
+  return distinct;
+}
+
+// ************************************************************
+int
+compareKeys (const void *a, const void *b)
+{
+  long long ka = *(const long long *) a;
+  long long kb = *(const long long *) b;
+
+  return (ka > kb) - (ka < kb);
+}
+
+// ************************************************************
+int
+createScratchFiles (BM_TraceRecord *records, int numRecords)
+{
+  int numFiles = 0;
+  int *maxPage;
+  int i;
+
+  for (i = 0; i < numRecords; i++)
+    if (records[i].fileId + 1 > numFiles)
+      numFiles = records[i].fileId + 1;
+
+  maxPage = calloc(numFiles, sizeof(int));
+  for (i = 0; i < numRecords; i++)
+    if (records[i].pageNum > maxPage[records[i].fileId])
+      maxPage[records[i].fileId] = records[i].pageNum;
+
+  for (i = 0; i < numFiles; i++)
+    {
+      SM_FileHandle fh;
+      char fileName[64];
+
+      sprintf(fileName, SIM_FILE_PATTERN, i);
+      CHECK(createPageFile(fileName));
+      CHECK(openPageFile(fileName, &fh));
+      CHECK(ensureCapacity(maxPage[i] + 1, &fh));
+      CHECK(closePageFile(&fh));
+    }
+
+  free(maxPage);
+  return numFiles;
+}
+
+// ************************************************************
+double
+replay (BM_TraceRecord *records, int numRecords, int numFiles,
+        SimStrategy *strategy, int poolSize)
+{
+  BM_BufferPool *pools = malloc(sizeof(BM_BufferPool) * numFiles);
+  BM_PoolOptions opts;
+  BM_PageHandle h;
+  BM_PoolStats stats;
+  int i;
+
+  initPoolOptions(&opts);
+  opts.adaptiveStrategy = strategy->adaptive;
+
+  // every file of the trace competes for the frames of one pool, as in the traced run
+  CHECK(initSharedBufferPool(poolSize, strategy->strategy, &opts));
+  for (i = 0; i < numFiles; i++)
+    {
+      char fileName[64];
+
+      sprintf(fileName, SIM_FILE_PATTERN, i);
+      CHECK(attachBufferPool(&pools[i], fileName));
+    }
+
+  for (i = 0; i < numRecords; i++)
+    {
+      CHECK(pinPage(&pools[records[i].fileId], &h, records[i].pageNum));
+      CHECK(unpinPage(&pools[records[i].fileId], &h));
+    }
+
+  getPoolStats(&pools[0], &stats);
+  for (i = 0; i < numFiles; i++)
+    CHECK(shutdownBufferPool(&pools[i]));
+  CHECK(shutdownSharedBufferPool());
+  free(pools);
+
+  return (stats.hits + stats.misses) ? (double) stats.hits / (stats.hits + stats.misses) : 0.0;
+}
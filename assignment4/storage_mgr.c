@@ -197,6 +197,48 @@ RC readBlock(int pageNum, SM_FileHandle *fHandle, SM_PageHandle memPage) {
     return RC_OK;
 }
 
+/*------
+FUNCTION: readBlocks
+DESCRIPTION: Reads `numPages` consecutive pages starting at `firstPage` into the given page buffers with a single open and seek. Returns `RC_READ_NON_EXISTING_PAGE` if any of them is past the end of the file.
+-----*/
+
+RC readBlocks(int firstPage, int numPages, SM_FileHandle *fHandle, SM_PageHandle *memPages) {
+    // Validate the file handle and page range
+    if (fHandle == NULL) {
+        return RC_FILE_HANDLE_NOT_INIT;
+    }
+    if (firstPage < 0 || numPages <= 0 || firstPage + numPages > fHandle->totalNumPages) {
+        return RC_READ_NON_EXISTING_PAGE;
+    }
+
+    // Open the file in read mode
+    FILE *filePtr = fopen(fHandle->fileName, "rb");
+    if (filePtr == NULL) {
+        return RC_FILE_NOT_FOUND;
+    }
+
+    // Move to the first page once; the rest follow sequentially
+    if (fseek(filePtr, (long)firstPage * PAGE_SIZE, SEEK_SET) != 0) {
+        fclose(filePtr);
+        return RC_READ_NON_EXISTING_PAGE;
+    }
+
+    for (int i = 0; i < numPages; i++) {
+        if (fread(memPages[i], sizeof(char), PAGE_SIZE, filePtr) < PAGE_SIZE) {
+            fclose(filePtr);
+            return RC_READ_NON_EXISTING_PAGE;
+        }
+    }
+
+    // Close the file
+    fclose(filePtr);
+
+    // Update the current page position
+    fHandle->curPagePos = firstPage + numPages - 1;
+
+    return RC_OK;
+}
+
 /*------
 AUTHOR: Ganesh Prasad Chandra Shekar
 FUNCTION: getBlockPos
@@ -443,6 +485,50 @@ RC writeBlock(int pageNum, SM_FileHandle *fHandle, SM_PageHandle memPage) {
     return RC_OK;
 }
 
+/*------
+FUNCTION: writeBlocks
+DESCRIPTION: Writes `numPages` page buffers to consecutive pages starting at `firstPage` with a single open and seek. Returns `RC_OK` if all were written or an error code otherwise.
+-----*/
+
+RC writeBlocks(int firstPage, int numPages, SM_FileHandle *fHandle, SM_PageHandle *memPages) {
+    // Validate the file handle and page range
+    if (fHandle == NULL || firstPage < 0 || numPages <= 0) {
+        return RC_WRITE_FAILED;
+    }
+
+    // Open the file in binary read/write mode
+    FILE *filePointer = fopen(fHandle->fileName, "r+b");
+    if (filePointer == NULL) {
+        return RC_FILE_NOT_FOUND;
+    }
+
+    // Move to the first page once; the rest follow sequentially
+    if (fseek(filePointer, (long)firstPage * PAGE_SIZE, SEEK_SET) != 0) {
+        fclose(filePointer);
+        return RC_WRITE_FAILED;
+    }
+
+    for (int i = 0; i < numPages; i++) {
+        if (fwrite(memPages[i], sizeof(char), PAGE_SIZE, filePointer) < PAGE_SIZE) {
+            fclose(filePointer);
+            return RC_WRITE_FAILED;
+        }
+    }
+
+    // Close the file after writing
+    if (fclose(filePointer) != 0) {
+        return RC_WRITE_FAILED;
+    }
+
+    // Update the current page position and the page count if the file grew
+    fHandle->curPagePos = firstPage + numPages - 1;
+    if (firstPage + numPages > fHandle->totalNumPages) {
+        fHandle->totalNumPages = firstPage + numPages;
+    }
+
+    return RC_OK;
+}
+
 /*------
 AUTHOR: Dhyan V Gowda
 FUNCTION: writeCurrentBlock
@@ -556,4 +642,4 @@ RC ensureCapacity(int numberOfPages, SM_FileHandle *fHandle) {
 
     // Return success code if capacity is ensured or no additional pages were needed
     return RC_OK;
-}
\ No newline at end of file
+}
\ No newline at end of file
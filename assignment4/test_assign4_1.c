@@ -3,6 +3,7 @@
 #include "dberror.h"
 #include "expr.h"
 #include "btree_mgr.h"
+#include "record_mgr.h"
 #include "tables.h"
 #include "test_helper.h"
 
@@ -15,6 +16,7 @@
 static void testInsertAndFind (void);
 static void testDelete (void);
 static void testIndexScan (void);
+static void testScanPrefetch (void);
 
 // helper methods
 static Value **createValues (char **stringVals, int size);
@@ -33,6 +35,7 @@ main (void)
   testInsertAndFind();
   testDelete();
   testIndexScan();
+  testScanPrefetch();
 
   return 0;
 }
@@ -265,6 +268,74 @@ testIndexScan (void)
   TEST_DONE();
 }
 
+// ************************************************************ 
+void
+testScanPrefetch (void)
+{
+  RM_TableData *table = (RM_TableData *) malloc(sizeof(RM_TableData));
+  RM_ScanHandle *sc = (RM_ScanHandle *) malloc(sizeof(RM_ScanHandle));
+  BM_BufferPool *probe = MAKE_POOL();
+  char *names[] = { "a" };
+  DataType dt[] = { DT_INT };
+  int sizes[] = { 0 };
+  int keys[] = { 0 };
+  int numInserts = 8000;
+  Schema *schema;
+  Record *r;
+  Value *v;
+  Expr *all;
+  RC rc;
+  int i;
+
+  testName = "record manager scan reads ahead";
+
+  // 5-byte records, 819 to a page, so the table spans about 10 pages
+  schema = createSchema(1, names, dt, sizes, 1, keys);
+  TEST_CHECK(initRecordManager(NULL));
+  TEST_CHECK(createTable("testscan", schema));
+  TEST_CHECK(openTable(table, "testscan"));
+  TEST_CHECK(createRecord(&r, schema));
+  for(i = 0; i < numInserts; i++)
+    {
+      MAKE_VALUE(v, DT_INT, i);
+      TEST_CHECK(setAttr(r, schema, 0, v));
+      freeVal(v);
+      TEST_CHECK(insertRecord(table, r));
+    }
+
+  // a second handle on the default shared pool the table lives in; shrinking
+  // the pool evicts the table's pages so the scan has to read them again
+  TEST_CHECK(createPageFile("testscan.probe"));
+  TEST_CHECK(attachBufferPool(probe, "testscan.probe"));
+  resizeBufferPool(probe, 1); // the table's pinned header page may stay
+  TEST_CHECK(resizeBufferPool(probe, SHARED_POOL_DEFAULT_PAGES));
+  ASSERT_EQUALS_INT(0, getNumPrefetches(probe), "no pages read ahead before the scan");
+
+  MAKE_CONS(all, stringToValue("btrue"));
+  TEST_CHECK(startScan(table, sc, all));
+  i = 0;
+  while((rc = next(sc, r)) == RC_OK)
+    i++;
+  ASSERT_EQUALS_INT(RC_RM_NO_MORE_TUPLES, rc, "scan ran to the end of the table");
+  ASSERT_EQUALS_INT(numInserts, i, "scan returned every record");
+  ASSERT_TRUE(getNumPrefetches(probe) > 0, "scan read pages ahead");
+  ASSERT_TRUE(getNumPrefetchHits(probe) > 0, "scan pinned the pages it read ahead");
+  TEST_CHECK(closeScan(sc));
+
+  TEST_CHECK(closeTable(table));
+  TEST_CHECK(deleteTable("testscan"));
+  TEST_CHECK(shutdownBufferPool(probe));
+  TEST_CHECK(destroyPageFile("testscan.probe"));
+  freeExpr(all);
+  freeRecord(r);
+  freeSchema(schema);
+  free(probe);
+  free(sc);
+  free(table);
+
+  TEST_DONE();
+}
+
 // ************************************************************ 
 int *
 createPermutation (int size)
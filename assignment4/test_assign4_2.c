@@ -0,0 +1,2256 @@
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <pthread.h>
+#include <unistd.h>
+
+#include "dberror.h"
+#include "storage_mgr.h"
+#include "buffer_mgr.h"
+#include "buffer_mgr_stat.h"
+#include "test_helper.h"
+
+#define TEST_PAGE_FILE "testbuffer.bin"
+#define TEST_PAGE_FILE_2 "testbuffer2.bin"
+#define TEST_TRACE_FILE "testtrace.bin"
+#define NUM_THREADS 8
+
+// test methods
+static void testSharedMissReadsOnce (void);
+static void testConcurrentPinning (void);
+static void testBackgroundWriter (void);
+static void testPrefetch (void);
+static void testSharedPool (void);
+static void testResize (void);
+static void testAccessRing (void);
+static void testFrameRefs (void);
+static void testPinBatch (void);
+static void testPoolStats (void);
+static void testWarmRestart (void);
+static void testPinTrace (void);
+static void testCheckpoint (void);
+static void testOptimisticReads (void);
+static void testFrameArena (void);
+static void testSyncScans (void);
+static void testGClock (void);
+static void testWriteBehind (void);
+static void testAdaptiveStrategy (void);
+static void testCompressedCache (void);
+static void testPageLatches (void);
+static void testScratchPages (void);
+static void testPinCache (void);
+static void testMemoryGovernor (void);
+
+// helper methods
+static void createStampedFile (char *fileName, int numPages);
+static bool isResident (BM_BufferPool *bm, PageNumber pageNum);
+static void *pinSamePage (void *arg);
+static void *pinRandomPages (void *arg);
+static void *readRandomPages (void *arg);
+static void *readWordsOptimistic (void *arg);
+static void *writeOwnPages (void *arg);
+static void *latchOnePage (void *arg);
+static void *latchedReadWrite (void *arg);
+static void waitForStart (void);
+
+// test name
+char *testName;
+
+// start gate so that all worker threads hit the pool at the same time
+static pthread_mutex_t startLatch = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t startCond = PTHREAD_COND_INITIALIZER;
+static int started;
+
+typedef struct WorkerArgs
+{
+  BM_BufferPool *bm;
+  unsigned int seed;
+  int numOps;
+  int numPages;
+  int errors;
+  int firstPage; // writeOwnPages: the worker's pages are [firstPage, firstPage + numPages); latchedReadWrite: 1 for a writer
+  int lastValue[16]; // writeOwnPages: value last written to each of them
+} WorkerArgs;
+
+// main method
+int
+main (void)
+{
+  testName = "";
+
+  initStorageManager();
+  testSharedMissReadsOnce();
+  testConcurrentPinning();
+  testBackgroundWriter();
+  testPrefetch();
+  testSharedPool();
+  testResize();
+  testAccessRing();
+  testFrameRefs();
+  testPinBatch();
+  testPoolStats();
+  testWarmRestart();
+  testPinTrace();
+  testCheckpoint();
+  testOptimisticReads();
+  testFrameArena();
+  testSyncScans();
+  testGClock();
+  testWriteBehind();
+  testAdaptiveStrategy();
+  testCompressedCache();
+  testPageLatches();
+  testScratchPages();
+  testPinCache();
+  testMemoryGovernor();
+
+  return 0;
+}
+
+// ************************************************************
+void
+testSharedMissReadsOnce (void)
+{
+  BM_BufferPool *bm = MAKE_POOL();
+  BM_PoolOptions opts;
+  pthread_t workers[NUM_THREADS];
+  WorkerArgs args[NUM_THREADS];
+  PageNumber *frameContents;
+  int *fixCounts;
+  int i, copies = 0;
+
+  testName = "concurrent misses on one page share a single frame";
+
+  createStampedFile(TEST_PAGE_FILE, 10);
+  initPoolOptions(&opts);
+  opts.threadSafe = true;
+  TEST_CHECK(initBufferPoolWithOptions(bm, TEST_PAGE_FILE, 4, RS_LRU, NULL, &opts));
+
+  started = 0;
+  for (i = 0; i < NUM_THREADS; i++)
+    {
+      args[i].bm = bm;
+      args[i].errors = 0;
+      pthread_create(&workers[i], NULL, pinSamePage, &args[i]);
+    }
+  pthread_mutex_lock(&startLatch);
+  started = 1;
+  pthread_cond_broadcast(&startCond);
+  pthread_mutex_unlock(&startLatch);
+  for (i = 0; i < NUM_THREADS; i++)
+    {
+      pthread_join(workers[i], NULL);
+      ASSERT_EQUALS_INT(0, args[i].errors, "worker saw the right page content");
+    }
+
+  frameContents = getFrameContents(bm);
+  fixCounts = getFixCounts(bm);
+  for (i = 0; i < bm->numPages; i++)
+    {
+      if (frameContents[i] == 3)
+        copies++;
+      ASSERT_EQUALS_INT(0, fixCounts[i], "all pins released");
+    }
+  ASSERT_EQUALS_INT(1, copies, "page 3 is resident in exactly one frame");
+
+  free(frameContents);
+  free(fixCounts);
+  TEST_CHECK(shutdownBufferPool(bm));
+  TEST_CHECK(destroyPageFile(TEST_PAGE_FILE));
+  free(bm);
+
+  TEST_DONE();
+}
+
+// ************************************************************
+void
+testConcurrentPinning (void)
+{
+  BM_BufferPool *bm = MAKE_POOL();
+  BM_PoolOptions opts;
+  pthread_t workers[NUM_THREADS];
+  WorkerArgs args[NUM_THREADS];
+  int *fixCounts;
+  int i;
+
+  testName = "many threads pinning random pages";
+
+  createStampedFile(TEST_PAGE_FILE, 40);
+  initPoolOptions(&opts);
+  opts.threadSafe = true;
+  TEST_CHECK(initBufferPoolWithOptions(bm, TEST_PAGE_FILE, 16, RS_CLOCK, NULL, &opts));
+
+  started = 0;
+  for (i = 0; i < NUM_THREADS; i++)
+    {
+      args[i].bm = bm;
+      args[i].seed = i + 1;
+      args[i].numOps = 2000;
+      args[i].numPages = 40;
+      args[i].errors = 0;
+      pthread_create(&workers[i], NULL, pinRandomPages, &args[i]);
+    }
+  pthread_mutex_lock(&startLatch);
+  started = 1;
+  pthread_cond_broadcast(&startCond);
+  pthread_mutex_unlock(&startLatch);
+  for (i = 0; i < NUM_THREADS; i++)
+    {
+      pthread_join(workers[i], NULL);
+      ASSERT_EQUALS_INT(0, args[i].errors, "every pinned frame held the requested page");
+    }
+
+  fixCounts = getFixCounts(bm);
+  for (i = 0; i < bm->numPages; i++)
+    ASSERT_EQUALS_INT(0, fixCounts[i], "all pins released");
+
+  free(fixCounts);
+  TEST_CHECK(shutdownBufferPool(bm));
+  TEST_CHECK(destroyPageFile(TEST_PAGE_FILE));
+  free(bm);
+
+  TEST_DONE();
+}
+
+// ************************************************************
+void
+testBackgroundWriter (void)
+{
+  BM_BufferPool *bm = MAKE_POOL();
+  BM_PoolOptions opts;
+  BM_PageHandle *h = MAKE_PAGE_HANDLE();
+  bool *dirty;
+  int i, waited, numDirty;
+
+  testName = "background writer cleans frames ahead of eviction";
+
+  createStampedFile(TEST_PAGE_FILE, 16);
+  initPoolOptions(&opts);
+  opts.backgroundWriter = true;
+  opts.bgWriterDelayMs = 1;
+  opts.bgWriterLowWater = 1.0;
+  opts.bgWriterHighWater = 1.0;
+  TEST_CHECK(initBufferPoolWithOptions(bm, TEST_PAGE_FILE, 8, RS_FIFO, NULL, &opts));
+
+  // dirty every frame
+  for (i = 0; i < 8; i++)
+    {
+      TEST_CHECK(pinPage(bm, h, i));
+      *((int *) h->data) = 100 + i;
+      TEST_CHECK(markDirty(bm, h));
+      TEST_CHECK(unpinPage(bm, h));
+    }
+
+  // give the writer up to a second to catch up; a frame reads clean as soon as its write starts
+  for (waited = 0, numDirty = 8; waited < 1000 && (numDirty > 0 || getNumBackgroundWrites(bm) < 8); waited++)
+    {
+      usleep(1000);
+      dirty = getDirtyFlags(bm);
+      for (i = 0, numDirty = 0; i < 8; i++)
+        numDirty += dirty[i] ? 1 : 0;
+      free(dirty);
+    }
+  ASSERT_EQUALS_INT(0, numDirty, "writer flushed all unpinned dirty frames");
+  ASSERT_EQUALS_INT(8, getNumBackgroundWrites(bm), "one background write per dirty page");
+
+  // evict all of them; none of the misses has to write
+  for (i = 8; i < 16; i++)
+    {
+      TEST_CHECK(pinPage(bm, h, i));
+      TEST_CHECK(unpinPage(bm, h));
+    }
+  ASSERT_EQUALS_INT(8, getNumEvictions(bm), "eight evictions");
+  ASSERT_EQUALS_INT(8, getNumCleanEvictions(bm), "every victim was clean");
+
+  // the flushed contents made it to disk
+  for (i = 0; i < 8; i++)
+    {
+      TEST_CHECK(pinPage(bm, h, i));
+      ASSERT_EQUALS_INT(100 + i, *((int *) h->data), "page content written back");
+      TEST_CHECK(unpinPage(bm, h));
+    }
+
+  TEST_CHECK(shutdownBufferPool(bm));
+  TEST_CHECK(destroyPageFile(TEST_PAGE_FILE));
+  free(h);
+  free(bm);
+
+  TEST_DONE();
+}
+
+// ************************************************************
+void
+testPrefetch (void)
+{
+  BM_BufferPool *bm = MAKE_POOL();
+  BM_PoolOptions opts;
+  BM_PageHandle *h = MAKE_PAGE_HANDLE();
+  PageNumber ahead[] = { 6, 7, 40 };
+  PageNumber *frameContents;
+  int i, waited, hasPage0 = 0, hasPage6 = 0;
+
+  testName = "prefetching pages without pinning them";
+
+  createStampedFile(TEST_PAGE_FILE, 16);
+
+  // synchronous: pages are cached unpinned, pages past the end are ignored
+  TEST_CHECK(initBufferPool(bm, TEST_PAGE_FILE, 8, RS_FIFO, NULL));
+  for (i = 0; i < 6; i++)
+    {
+      TEST_CHECK(pinPage(bm, h, i));
+      TEST_CHECK(unpinPage(bm, h));
+    }
+  TEST_CHECK(prefetchPages(bm, ahead, 3));
+  ASSERT_EQUALS_INT(2, getNumPrefetches(bm), "two pages prefetched, one past the end skipped");
+
+  // an unused prefetch is evicted before the FIFO head once it has aged
+  TEST_CHECK(pinPage(bm, h, 8));
+  TEST_CHECK(unpinPage(bm, h));
+  frameContents = getFrameContents(bm);
+  for (i = 0; i < 8; i++)
+    {
+      hasPage0 |= frameContents[i] == 0;
+      hasPage6 |= frameContents[i] == 6;
+    }
+  free(frameContents);
+  ASSERT_TRUE(hasPage0 && !hasPage6, "stale prefetched page 6 was evicted instead of page 0");
+  ASSERT_EQUALS_INT(1, getNumPrefetchWasted(bm), "one prefetch wasted");
+
+  TEST_CHECK(pinPage(bm, h, 7));
+  ASSERT_EQUALS_INT(7, *((int *) h->data), "prefetched page content");
+  TEST_CHECK(unpinPage(bm, h));
+  ASSERT_EQUALS_INT(1, getNumPrefetchHits(bm), "one prefetch used");
+  TEST_CHECK(shutdownBufferPool(bm));
+
+  // asynchronous: the prefetch thread reads the pages in the background
+  initPoolOptions(&opts);
+  opts.asyncPrefetch = true;
+  TEST_CHECK(initBufferPoolWithOptions(bm, TEST_PAGE_FILE, 8, RS_LRU, NULL, &opts));
+  TEST_CHECK(prefetchPages(bm, ahead, 2));
+  for (waited = 0; waited < 1000 && getNumPrefetches(bm) < 2; waited++)
+    usleep(1000);
+  ASSERT_EQUALS_INT(2, getNumPrefetches(bm), "prefetch thread read both pages");
+  for (i = 0; i < 2; i++)
+    {
+      TEST_CHECK(pinPage(bm, h, ahead[i]));
+      ASSERT_EQUALS_INT(ahead[i], *((int *) h->data), "prefetched page content");
+      TEST_CHECK(unpinPage(bm, h));
+    }
+  ASSERT_EQUALS_INT(2, getNumPrefetchHits(bm), "both prefetches used");
+
+  TEST_CHECK(shutdownBufferPool(bm));
+  TEST_CHECK(destroyPageFile(TEST_PAGE_FILE));
+  free(h);
+  free(bm);
+
+  TEST_DONE();
+}
+
+// ************************************************************
+void
+testSharedPool (void)
+{
+  BM_BufferPool *table = MAKE_POOL();
+  BM_BufferPool *index = MAKE_POOL();
+  BM_PageHandle *h = MAKE_PAGE_HANDLE();
+  PageNumber *frameContents;
+  int i, tablePages = 0, indexPages = 0;
+
+  testName = "one shared pool caching pages of several files";
+
+  createStampedFile(TEST_PAGE_FILE, 10);
+  createStampedFile(TEST_PAGE_FILE_2, 10);
+  TEST_CHECK(initSharedBufferPool(4, RS_LRU, NULL));
+  ASSERT_TRUE(initSharedBufferPool(4, RS_LRU, NULL) != RC_OK, "only one shared pool");
+  TEST_CHECK(attachBufferPool(table, TEST_PAGE_FILE));
+  TEST_CHECK(attachBufferPool(index, TEST_PAGE_FILE_2));
+  ASSERT_EQUALS_INT(4, index->numPages, "handles see the shared frame count");
+
+  // the same page number in two files lives in two frames
+  TEST_CHECK(pinPage(table, h, 1));
+  ASSERT_EQUALS_INT(1, *((int *) h->data), "table page content");
+  *((int *) h->data) = 101;
+  TEST_CHECK(markDirty(table, h));
+  TEST_CHECK(unpinPage(table, h));
+  TEST_CHECK(pinPage(index, h, 1));
+  ASSERT_EQUALS_INT(1, *((int *) h->data), "index page is not the dirty table page");
+  TEST_CHECK(unpinPage(index, h));
+
+  // a hot file takes frames from a cold one
+  for (i = 2; i < 5; i++)
+    {
+      TEST_CHECK(pinPage(index, h, i));
+      TEST_CHECK(unpinPage(index, h));
+    }
+  frameContents = getFrameContents(table);
+  for (i = 0; i < 4; i++)
+    tablePages += frameContents[i] != NO_PAGE;
+  free(frameContents);
+  frameContents = getFrameContents(index);
+  for (i = 0; i < 4; i++)
+    indexPages += frameContents[i] != NO_PAGE;
+  free(frameContents);
+  ASSERT_EQUALS_INT(0, tablePages, "table page evicted by the index");
+  ASSERT_EQUALS_INT(4, indexPages, "index holds every frame");
+
+  // the evicted dirty page went to its own file
+  TEST_CHECK(pinPage(table, h, 1));
+  ASSERT_EQUALS_INT(101, *((int *) h->data), "dirty table page written back to the table file");
+  TEST_CHECK(unpinPage(table, h));
+
+  // shutting down one handle leaves the other and the pool running
+  TEST_CHECK(shutdownBufferPool(table));
+  ASSERT_EQUALS_INT(RC_PINNED_PAGES_IN_BUFFER, shutdownSharedBufferPool(), "pool still in use");
+  TEST_CHECK(pinPage(index, h, 3));
+  ASSERT_EQUALS_INT(3, *((int *) h->data), "index page content");
+  TEST_CHECK(unpinPage(index, h));
+  TEST_CHECK(shutdownBufferPool(index));
+  TEST_CHECK(shutdownSharedBufferPool());
+
+  // without initSharedBufferPool the first attach creates a default pool
+  TEST_CHECK(attachBufferPool(table, TEST_PAGE_FILE));
+  ASSERT_EQUALS_INT(SHARED_POOL_DEFAULT_PAGES, table->numPages, "default shared pool size");
+  TEST_CHECK(shutdownBufferPool(table));
+  ASSERT_EQUALS_INT(RC_FILE_HANDLE_NOT_INIT, shutdownSharedBufferPool(), "default pool freed with its last handle");
+
+  TEST_CHECK(destroyPageFile(TEST_PAGE_FILE));
+  TEST_CHECK(destroyPageFile(TEST_PAGE_FILE_2));
+  free(h);
+  free(table);
+  free(index);
+
+  TEST_DONE();
+}
+
+// ************************************************************
+void
+testResize (void)
+{
+  BM_BufferPool *bm = MAKE_POOL();
+  BM_PoolOptions opts;
+  BM_PageHandle *h = MAKE_PAGE_HANDLE();
+  BM_PageHandle *held = MAKE_PAGE_HANDLE();
+  pthread_t workers[NUM_THREADS];
+  WorkerArgs args[NUM_THREADS];
+  PageNumber *frameContents;
+  int i, cached = 0, errors = 0;
+
+  testName = "growing and shrinking a running pool";
+
+  createStampedFile(TEST_PAGE_FILE, 64);
+  initPoolOptions(&opts);
+  opts.threadSafe = true;
+  TEST_CHECK(initBufferPoolWithOptions(bm, TEST_PAGE_FILE, 3, RS_FIFO, NULL, &opts));
+  for (i = 0; i < 3; i++)
+    {
+      TEST_CHECK(pinPage(bm, h, i));
+      TEST_CHECK(unpinPage(bm, h));
+    }
+
+  // new frames are used before anything is evicted
+  TEST_CHECK(resizeBufferPool(bm, 5));
+  ASSERT_EQUALS_INT(5, bm->numPages, "pool grown");
+  for (i = 3; i < 5; i++)
+    {
+      TEST_CHECK(pinPage(bm, h, i));
+      TEST_CHECK(unpinPage(bm, h));
+    }
+  ASSERT_EQUALS_INT(0, getNumEvictions(bm), "no eviction after growing");
+  frameContents = getFrameContents(bm);
+  for (i = 0; i < 5; i++)
+    cached += frameContents[i] != NO_PAGE;
+  free(frameContents);
+  ASSERT_EQUALS_INT(5, cached, "cached pages survived the resize");
+
+  // shrinking writes dirty victims back and stops at pinned frames
+  TEST_CHECK(pinPage(bm, held, 0));
+  *((int *) held->data) = 100;
+  TEST_CHECK(markDirty(bm, held));
+  TEST_CHECK(pinPage(bm, h, 1));
+  ASSERT_EQUALS_INT(RC_PINNED_PAGES_IN_BUFFER, resizeBufferPool(bm, 1), "pinned frames block shrinking");
+  ASSERT_EQUALS_INT(2, bm->numPages, "shrunk as far as the pins allow");
+  frameContents = getFrameContents(bm);
+  ASSERT_TRUE((frameContents[0] == 0 && frameContents[1] == 1) || (frameContents[0] == 1 && frameContents[1] == 0),
+              "pinned pages stay resident");
+  free(frameContents);
+  TEST_CHECK(unpinPage(bm, h));
+  TEST_CHECK(unpinPage(bm, held));
+  TEST_CHECK(resizeBufferPool(bm, 1));
+  TEST_CHECK(pinPage(bm, h, 0));
+  ASSERT_EQUALS_INT(100, *((int *) h->data), "dirty page written back while shrinking");
+  *((int *) h->data) = 0;
+  TEST_CHECK(markDirty(bm, h));
+  TEST_CHECK(unpinPage(bm, h));
+
+  // a victim whose write fails keeps its page, still dirty, and the pool its size
+  TEST_CHECK(resizeBufferPool(bm, 2));
+  TEST_CHECK(pinPage(bm, h, 1));
+  *((int *) h->data) = 101;
+  TEST_CHECK(markDirty(bm, h));
+  TEST_CHECK(unpinPage(bm, h));
+  ASSERT_TRUE(rename(TEST_PAGE_FILE, TEST_PAGE_FILE_2) == 0, "page file moved away");
+  ASSERT_TRUE(resizeBufferPool(bm, 1) != RC_OK, "shrinking fails when the victim cannot be written");
+  ASSERT_EQUALS_INT(2, bm->numPages, "no frame given up");
+  ASSERT_TRUE(isResident(bm, 0) && isResident(bm, 1), "both pages still resident");
+  ASSERT_TRUE(rename(TEST_PAGE_FILE_2, TEST_PAGE_FILE) == 0, "page file moved back");
+  TEST_CHECK(resizeBufferPool(bm, 1));
+  TEST_CHECK(pinPage(bm, h, 1));
+  ASSERT_EQUALS_INT(101, *((int *) h->data), "dirty page kept through the failed write");
+  *((int *) h->data) = 1;
+  TEST_CHECK(markDirty(bm, h));
+  TEST_CHECK(unpinPage(bm, h));
+
+  // resizing while other threads keep pinning
+  started = 0;
+  for (i = 0; i < NUM_THREADS; i++)
+    {
+      args[i].bm = bm;
+      args[i].seed = 11 * (i + 1);
+      args[i].numOps = 2000;
+      args[i].numPages = 64;
+      args[i].errors = 0;
+      pthread_create(&workers[i], NULL, pinRandomPages, &args[i]);
+    }
+  pthread_mutex_lock(&startLatch);
+  started = 1;
+  pthread_cond_broadcast(&startCond);
+  pthread_mutex_unlock(&startLatch);
+  for (i = 0; i < 50; i++)
+    {
+      RC rc = resizeBufferPool(bm, (i % 2 == 0) ? 32 : 4 + i % 5);
+      if (rc != RC_OK && rc != RC_PINNED_PAGES_IN_BUFFER)
+        errors++;
+    }
+  for (i = 0; i < NUM_THREADS; i++)
+    {
+      pthread_join(workers[i], NULL);
+      errors += args[i].errors;
+    }
+  ASSERT_EQUALS_INT(0, errors, "every pin saw the right page while the pool was resized");
+  TEST_CHECK(resizeBufferPool(bm, 8));
+  ASSERT_EQUALS_INT(8, bm->numPages, "final size");
+
+  TEST_CHECK(shutdownBufferPool(bm));
+  TEST_CHECK(destroyPageFile(TEST_PAGE_FILE));
+  free(h);
+  free(held);
+  free(bm);
+
+  TEST_DONE();
+}
+
+// ************************************************************
+void
+testAccessRing (void)
+{
+  BM_BufferPool *bm = MAKE_POOL();
+  BM_PageHandle *h = MAKE_PAGE_HANDLE();
+  BM_AccessRing *ring = createAccessRing(2);
+  PageNumber *frameContents;
+  int i, hotPages = 0, scanPages = 0;
+
+  testName = "scans recycle a private ring of frames";
+
+  createStampedFile(TEST_PAGE_FILE, 40);
+  TEST_CHECK(initBufferPool(bm, TEST_PAGE_FILE, 8, RS_LRU, NULL));
+  for (i = 0; i < 4; i++)
+    {
+      TEST_CHECK(pinPage(bm, h, i));
+      TEST_CHECK(unpinPage(bm, h));
+    }
+
+  // a full scan through the ring
+  for (i = 10; i < 40; i++)
+    {
+      TEST_CHECK(pinPageWithRing(bm, h, i, ring));
+      ASSERT_EQUALS_INT(i, *((int *) h->data), "scanned page content");
+      TEST_CHECK(unpinPage(bm, h));
+    }
+
+  frameContents = getFrameContents(bm);
+  for (i = 0; i < 8; i++)
+    {
+      hotPages += frameContents[i] >= 0 && frameContents[i] < 4;
+      scanPages += frameContents[i] >= 10;
+    }
+  free(frameContents);
+  ASSERT_EQUALS_INT(4, hotPages, "the scan left the other pages cached");
+  ASSERT_EQUALS_INT(2, scanPages, "the scan used two frames");
+
+  // pinning without a ring after the scan still works normally
+  TEST_CHECK(pinPage(bm, h, 39));
+  ASSERT_EQUALS_INT(39, *((int *) h->data), "ring page is a normal cached page");
+  TEST_CHECK(unpinPage(bm, h));
+
+  freeAccessRing(ring);
+  TEST_CHECK(shutdownBufferPool(bm));
+
+  // a scan reading two pages ahead through its ring stays within the ring as well; the pool is
+  // big enough that pages read ahead are not taken as stale prefetches before they are pinned
+  ring = createAccessRing(4);
+  TEST_CHECK(initBufferPool(bm, TEST_PAGE_FILE, 16, RS_LRU, NULL));
+  for (i = 0; i < 4; i++)
+    {
+      TEST_CHECK(pinPage(bm, h, i));
+      TEST_CHECK(unpinPage(bm, h));
+    }
+  for (i = 10; i < 40; i++)
+    {
+      PageNumber ahead[2] = { i + 1, i + 2 };
+      TEST_CHECK(prefetchPagesWithRing(bm, ahead, 2, ring));
+      TEST_CHECK(pinPageWithRing(bm, h, i, ring));
+      ASSERT_EQUALS_INT(i, *((int *) h->data), "page read ahead");
+      TEST_CHECK(unpinPage(bm, h));
+    }
+
+  hotPages = scanPages = 0;
+  frameContents = getFrameContents(bm);
+  for (i = 0; i < 16; i++)
+    {
+      hotPages += frameContents[i] >= 0 && frameContents[i] < 4;
+      scanPages += frameContents[i] >= 10;
+    }
+  free(frameContents);
+  ASSERT_EQUALS_INT(4, hotPages, "reading ahead left the other pages cached");
+  ASSERT_EQUALS_INT(4, scanPages, "the scan and its read-ahead used the ring's four frames");
+  ASSERT_EQUALS_INT(34, getNumReadIO(bm), "every page read once");
+  ASSERT_EQUALS_INT(29, getNumPrefetchHits(bm), "every page after the first was read ahead");
+
+  freeAccessRing(ring);
+  TEST_CHECK(shutdownBufferPool(bm));
+  TEST_CHECK(destroyPageFile(TEST_PAGE_FILE));
+  free(h);
+  free(bm);
+
+  TEST_DONE();
+}
+
+// ************************************************************
+void
+testFrameRefs (void)
+{
+  BM_BufferPool *bm = MAKE_POOL();
+  BM_PageHandle *h = MAKE_PAGE_HANDLE();
+  BM_PageHandle *other = MAKE_PAGE_HANDLE();
+  SM_FileHandle fh;
+  char page[PAGE_SIZE];
+  bool *dirty;
+  int *fixCounts;
+
+  testName = "unpin, markDirty and forcePage through the pinned frame";
+
+  createStampedFile(TEST_PAGE_FILE, 4);
+  TEST_CHECK(initBufferPool(bm, TEST_PAGE_FILE, 2, RS_FIFO, NULL));
+
+  TEST_CHECK(pinPage(bm, h, 1));
+  TEST_CHECK(pinPage(bm, other, 1));
+  ASSERT_TRUE(h->frameRef != NULL && h->frameRef == other->frameRef, "both handles refer to the same frame");
+  *((int *) h->data) = 77;
+  TEST_CHECK(markDirtyRef(bm, h));
+  dirty = getDirtyFlags(bm);
+  ASSERT_TRUE(dirty[0], "frame marked dirty");
+  free(dirty);
+
+  TEST_CHECK(forcePageRef(bm, h));
+  TEST_CHECK(openPageFile(TEST_PAGE_FILE, &fh));
+  TEST_CHECK(readBlock(1, &fh, page));
+  TEST_CHECK(closePageFile(&fh));
+  ASSERT_EQUALS_INT(77, *((int *) page), "forced page is on disk");
+  TEST_CHECK(unpinPageRef(bm, h));
+  ASSERT_TRUE(h->frameRef == NULL, "unpinning clears the reference");
+  ASSERT_EQUALS_INT(RC_READ_NON_EXISTING_PAGE, unpinPageRef(bm, h), "second unpin through the handle fails");
+  fixCounts = getFixCounts(bm);
+  ASSERT_EQUALS_INT(1, fixCounts[0], "the other pin is kept");
+  free(fixCounts);
+
+  // the compatibility calls work on the same handles
+  TEST_CHECK(unpinPage(bm, other));
+  ASSERT_TRUE(other->frameRef == NULL, "unpinPage clears the reference too");
+
+  // a failed pin leaves no reference behind
+  ASSERT_TRUE(pinPage(bm, h, -1) != RC_OK, "negative page number");
+  ASSERT_EQUALS_INT(RC_READ_NON_EXISTING_PAGE, markDirtyRef(bm, h), "nothing pinned through the handle");
+
+  TEST_CHECK(shutdownBufferPool(bm));
+
+  TEST_CHECK(destroyPageFile(TEST_PAGE_FILE));
+  free(h);
+  free(other);
+  free(bm);
+
+  TEST_DONE();
+}
+
+// ************************************************************
+void
+testPinBatch (void)
+{
+  BM_BufferPool *bm = MAKE_POOL();
+  BM_PageHandle h;
+  BM_PageHandle batch[9];
+  PageNumber pageNums[] = {5, 2, 3, 4, 5, 9};
+  PageNumber tooMany[] = {10, 11, 12, 13, 14, 15, 16, 17, 18};
+  int *fixCounts;
+  int i, pinned = 0;
+
+  testName = "pinning and unpinning a batch of pages";
+
+  createStampedFile(TEST_PAGE_FILE, 20);
+  TEST_CHECK(initBufferPool(bm, TEST_PAGE_FILE, 8, RS_LRU, NULL));
+  TEST_CHECK(pinPage(bm, &h, 2));
+
+  // a resident page, a duplicate and a run of consecutive misses
+  TEST_CHECK(pinPages(bm, batch, pageNums, 6));
+  for (i = 0; i < 6; i++)
+    {
+      ASSERT_EQUALS_INT(pageNums[i], batch[i].pageNum, "handle page number");
+      ASSERT_EQUALS_INT(pageNums[i], *((int *) batch[i].data), "batch page content");
+    }
+  ASSERT_TRUE(batch[0].frameRef == batch[4].frameRef, "duplicate pinned in one frame");
+  ASSERT_TRUE(batch[1].frameRef == h.frameRef, "resident page pinned in place");
+
+  fixCounts = getFixCounts(bm);
+  for (i = 0; i < 8; i++)
+    pinned += fixCounts[i];
+  free(fixCounts);
+  ASSERT_EQUALS_INT(7, pinned, "one pin per handle");
+
+  TEST_CHECK(unpinPages(bm, batch, 6));
+  TEST_CHECK(unpinPageRef(bm, &h));
+
+  // more misses than frames: nothing of the batch stays pinned
+  ASSERT_EQUALS_INT(RC_IM_NO_MORE_ENTRIES, pinPages(bm, batch, tooMany, 9), "batch larger than the pool");
+  fixCounts = getFixCounts(bm);
+  for (i = 0; i < 8; i++)
+    ASSERT_EQUALS_INT(0, fixCounts[i], "failed batch leaves no pins");
+  free(fixCounts);
+
+  // the pool is still usable afterwards
+  TEST_CHECK(pinPages(bm, batch, tooMany, 8));
+  ASSERT_EQUALS_INT(17, *((int *) batch[7].data), "batch filling the whole pool");
+  TEST_CHECK(unpinPages(bm, batch, 8));
+
+  TEST_CHECK(shutdownBufferPool(bm));
+  TEST_CHECK(destroyPageFile(TEST_PAGE_FILE));
+  free(bm);
+
+  TEST_DONE();
+}
+
+// ************************************************************
+void
+testPoolStats (void)
+{
+  BM_BufferPool *bm = MAKE_POOL();
+  BM_PageHandle *h = MAKE_PAGE_HANDLE();
+  BM_PoolStats stats;
+  char *dump;
+  long sum;
+  int i;
+
+  testName = "hit, miss, eviction and latency counters";
+
+  createStampedFile(TEST_PAGE_FILE, 8);
+  TEST_CHECK(initBufferPool(bm, TEST_PAGE_FILE, 3, RS_FIFO, NULL));
+
+  // three misses into empty frames, one hit, then a miss evicting dirty page 0
+  for (i = 0; i < 3; i++)
+    {
+      TEST_CHECK(pinPage(bm, h, i));
+      TEST_CHECK(unpinPage(bm, h));
+    }
+  TEST_CHECK(pinPage(bm, h, 0));
+  TEST_CHECK(markDirty(bm, h));
+  TEST_CHECK(unpinPage(bm, h));
+  TEST_CHECK(pinPage(bm, h, 3));
+  TEST_CHECK(unpinPage(bm, h));
+
+  getPoolStats(bm, &stats);
+  ASSERT_EQUALS_INT(RS_FIFO, stats.strategy, "strategy");
+  ASSERT_EQUALS_LONG(1, stats.hits, "hits");
+  ASSERT_EQUALS_LONG(4, stats.misses, "misses");
+  ASSERT_EQUALS_LONG(4, stats.readIO, "reads");
+  ASSERT_EQUALS_INT(4, getNumReadIO(bm), "getNumReadIO");
+  ASSERT_EQUALS_INT(1, getNumWriteIO(bm), "getNumWriteIO");
+  ASSERT_EQUALS_LONG(1, stats.evictions, "evictions");
+  ASSERT_EQUALS_LONG(1, stats.dirtyEvictions, "dirty evictions");
+  ASSERT_EQUALS_LONG(0, stats.pinWaits, "no concurrent reads");
+  ASSERT_EQUALS_LONG(4, stats.victimSearches, "one victim search per miss");
+  ASSERT_EQUALS_LONG(4, stats.searchLength[0], "FIFO always takes the head frame");
+
+  for (sum = 0, i = 0; i < BM_LATENCY_BUCKETS; i++)
+    sum += stats.hitLatency[i];
+  ASSERT_EQUALS_LONG(1, sum, "hit latency samples");
+  for (sum = 0, i = 0; i < BM_LATENCY_BUCKETS; i++)
+    sum += stats.missLatency[i];
+  ASSERT_EQUALS_LONG(4, sum, "miss latency samples");
+
+  dump = sprintPoolStats(bm, TRUE);
+  ASSERT_TRUE(strstr(dump, "\"hits\":1,\"misses\":4") != NULL, "JSON dump");
+  free(dump);
+  dump = sprintPoolStats(bm, FALSE);
+  ASSERT_TRUE(strstr(dump, "evictions 1 dirty 1") != NULL, "text dump");
+  free(dump);
+
+  TEST_CHECK(shutdownBufferPool(bm));
+  TEST_CHECK(destroyPageFile(TEST_PAGE_FILE));
+  free(h);
+  free(bm);
+
+  TEST_DONE();
+}
+
+// ************************************************************
+void
+testWarmRestart (void)
+{
+  BM_BufferPool *bm = MAKE_POOL();
+  BM_PageHandle *h = MAKE_PAGE_HANDLE();
+  BM_PoolOptions opts;
+  BM_PoolStats stats;
+  PageNumber touched[] = {7, 2, 5, 9, 2};
+  PageNumber saved[5];
+  PageNumber *frameContents;
+  FILE *hotFile;
+  int i, count = 0;
+
+  testName = "saving the hot pages on shutdown and preloading them";
+
+  createStampedFile(TEST_PAGE_FILE, 12);
+  initPoolOptions(&opts);
+  opts.saveHotPages = TRUE;
+  TEST_CHECK(initBufferPoolWithOptions(bm, TEST_PAGE_FILE, 4, RS_LRU, NULL, &opts));
+  for (i = 0; i < 5; i++)
+    {
+      TEST_CHECK(pinPage(bm, h, touched[i]));
+      TEST_CHECK(unpinPage(bm, h));
+    }
+  TEST_CHECK(shutdownBufferPool(bm));
+
+  // most recently used first
+  hotFile = fopen(TEST_PAGE_FILE HOT_PAGES_SUFFIX, "rb");
+  ASSERT_TRUE(hotFile != NULL, "hot-page list written on shutdown");
+  ASSERT_TRUE(fread(&count, sizeof(int), 1, hotFile) == 1, "list has a page count");
+  ASSERT_EQUALS_INT(4, count, "one entry per resident page");
+  ASSERT_TRUE(fread(saved, sizeof(PageNumber), count, hotFile) == (size_t) count, "list has the pages");
+  fclose(hotFile);
+  ASSERT_EQUALS_INT(2, saved[0], "hottest page first");
+  ASSERT_EQUALS_INT(9, saved[1], "then by recency");
+  ASSERT_EQUALS_INT(7, saved[3], "coldest page last");
+
+  // a smaller pool preloads the three hottest pages before the first pin
+  initPoolOptions(&opts);
+  opts.preloadHotPages = TRUE;
+  TEST_CHECK(initBufferPoolWithOptions(bm, TEST_PAGE_FILE, 3, RS_LRU, NULL, &opts));
+  ASSERT_EQUALS_INT(3, getNumReadIO(bm), "three pages preloaded");
+  TEST_CHECK(pinPage(bm, h, 9));
+  ASSERT_EQUALS_INT(9, *((int *) h->data), "preloaded page content");
+  TEST_CHECK(unpinPage(bm, h));
+  getPoolStats(bm, &stats);
+  ASSERT_EQUALS_LONG(1, stats.hits, "first pin after the restart is a hit");
+
+  // the saved order survives the preload: page 5 is now the least recently used
+  TEST_CHECK(pinPage(bm, h, 0));
+  TEST_CHECK(unpinPage(bm, h));
+  frameContents = getFrameContents(bm);
+  for (i = 0; i < 3; i++)
+    ASSERT_TRUE(frameContents[i] != 5, "coldest preloaded page evicted first");
+  free(frameContents);
+
+  TEST_CHECK(shutdownBufferPool(bm));
+  remove(TEST_PAGE_FILE HOT_PAGES_SUFFIX);
+
+  // periodic saves while the file stays attached
+  initPoolOptions(&opts);
+  opts.saveHotPages = TRUE;
+  opts.hotPagesIntervalMs = 5;
+  TEST_CHECK(initBufferPoolWithOptions(bm, TEST_PAGE_FILE, 3, RS_CLOCK, NULL, &opts));
+  TEST_CHECK(pinPage(bm, h, 4));
+  TEST_CHECK(unpinPage(bm, h));
+  for (count = 0, i = 0; i < 200 && count != 1; i++)
+    {
+      usleep(10000);
+      if ((hotFile = fopen(TEST_PAGE_FILE HOT_PAGES_SUFFIX, "rb")) == NULL)
+        continue;
+      if (fread(&count, sizeof(int), 1, hotFile) != 1)
+        count = 0;
+      fclose(hotFile);
+    }
+  ASSERT_EQUALS_INT(1, count, "hot-page list written while running");
+  TEST_CHECK(shutdownBufferPool(bm));
+  remove(TEST_PAGE_FILE HOT_PAGES_SUFFIX);
+
+  TEST_CHECK(destroyPageFile(TEST_PAGE_FILE));
+  free(h);
+  free(bm);
+
+  TEST_DONE();
+}
+
+// ************************************************************
+void
+testPinTrace (void)
+{
+  BM_BufferPool *bm = MAKE_POOL();
+  BM_PageHandle h, batch[2];
+  BM_TraceHeader header;
+  BM_TraceRecord records[8];
+  PageNumber pageNums[] = {6, 7};
+  PageNumber expected[] = {3, 1, 3, 6, 7};
+  FILE *traceFile;
+  int i, numRecords;
+
+  testName = "tracing pin requests to a binary log";
+
+  createStampedFile(TEST_PAGE_FILE, 8);
+  TEST_CHECK(initBufferPool(bm, TEST_PAGE_FILE, 3, RS_CLOCK, NULL));
+  TEST_CHECK(pinPage(bm, &h, 0));
+  TEST_CHECK(unpinPage(bm, &h));
+
+  TEST_CHECK(startPinTrace(bm, TEST_TRACE_FILE));
+  for (i = 0; i < 3; i++)
+    {
+      TEST_CHECK(pinPage(bm, &h, expected[i]));
+      TEST_CHECK(unpinPage(bm, &h));
+    }
+  ASSERT_TRUE(pinPage(bm, &h, -1) != RC_OK, "invalid pins are not traced");
+  TEST_CHECK(pinPages(bm, batch, pageNums, 2));
+  TEST_CHECK(unpinPages(bm, batch, 2));
+  TEST_CHECK(stopPinTrace(bm));
+  ASSERT_EQUALS_INT(RC_FILE_HANDLE_NOT_INIT, stopPinTrace(bm), "no trace running");
+
+  // pins after the trace stopped are not recorded
+  TEST_CHECK(pinPage(bm, &h, 5));
+  TEST_CHECK(unpinPage(bm, &h));
+
+  traceFile = fopen(TEST_TRACE_FILE, "rb");
+  ASSERT_TRUE(traceFile != NULL, "trace file written");
+  ASSERT_TRUE(fread(&header, sizeof(header), 1, traceFile) == 1, "trace header");
+  ASSERT_EQUALS_INT(PIN_TRACE_MAGIC, header.magic, "trace magic");
+  ASSERT_EQUALS_INT((int) sizeof(BM_TraceRecord), header.recordSize, "record size");
+  numRecords = fread(records, sizeof(BM_TraceRecord), 8, traceFile);
+  fclose(traceFile);
+  ASSERT_EQUALS_INT(5, numRecords, "one record per page pinned");
+  for (i = 0; i < numRecords; i++)
+    ASSERT_EQUALS_INT(expected[i], records[i].pageNum, "pinned page in order");
+
+  TEST_CHECK(shutdownBufferPool(bm));
+  remove(TEST_TRACE_FILE);
+  TEST_CHECK(destroyPageFile(TEST_PAGE_FILE));
+  free(bm);
+
+  TEST_DONE();
+}
+
+// ************************************************************
+void
+testCheckpoint (void)
+{
+  BM_BufferPool *bm = MAKE_POOL();
+  BM_PageHandle h, held;
+  SM_FileHandle fh;
+  char page[PAGE_SIZE];
+  PageNumber dirtied[] = {6, 2, 7, 0, 9, 10, 11};
+  bool *dirty;
+  int i, writes;
+
+  testName = "checkpointing the dirty pages in page order";
+
+  createStampedFile(TEST_PAGE_FILE, 12);
+  TEST_CHECK(initBufferPool(bm, TEST_PAGE_FILE, 8, RS_LRU, NULL));
+
+  // dirty some pages, one of them still pinned by its writer
+  TEST_CHECK(pinPage(bm, &held, 3));
+  *((int *) held.data) = 103;
+  TEST_CHECK(markDirtyRef(bm, &held));
+  for (i = 0; i < 4; i++)
+    {
+      TEST_CHECK(pinPage(bm, &h, dirtied[i]));
+      *((int *) h.data) = 100 + dirtied[i];
+      TEST_CHECK(markDirtyRef(bm, &h));
+      TEST_CHECK(unpinPageRef(bm, &h));
+    }
+
+  writes = getNumWriteIO(bm);
+  TEST_CHECK(checkpointPool(bm, 2, 1));
+  ASSERT_EQUALS_INT(writes + 5, getNumWriteIO(bm), "each dirty page written once");
+  dirty = getDirtyFlags(bm);
+  for (i = 0; i < 8; i++)
+    ASSERT_TRUE(!dirty[i], "no dirty frame left");
+  free(dirty);
+
+  TEST_CHECK(openPageFile(TEST_PAGE_FILE, &fh));
+  TEST_CHECK(readBlock(3, &fh, page));
+  ASSERT_EQUALS_INT(103, *((int *) page), "pinned dirty page checkpointed");
+  for (i = 0; i < 4; i++)
+    {
+      TEST_CHECK(readBlock(dirtied[i], &fh, page));
+      ASSERT_EQUALS_INT(100 + dirtied[i], *((int *) page), "dirty page on disk");
+    }
+  TEST_CHECK(closePageFile(&fh));
+
+  // nothing dirty: nothing written
+  TEST_CHECK(forceFlushPool(bm));
+  ASSERT_EQUALS_INT(writes + 5, getNumWriteIO(bm), "clean pool flushes nothing");
+
+  // the dirty set follows the pool when it grows
+  TEST_CHECK(unpinPageRef(bm, &held));
+  TEST_CHECK(resizeBufferPool(bm, 12));
+  for (i = 4; i < 7; i++)
+    {
+      TEST_CHECK(pinPage(bm, &h, dirtied[i]));
+      TEST_CHECK(markDirtyRef(bm, &h));
+      TEST_CHECK(unpinPageRef(bm, &h));
+    }
+  TEST_CHECK(forceFlushPool(bm));
+  ASSERT_EQUALS_INT(writes + 8, getNumWriteIO(bm), "pages dirtied after the resize flushed");
+
+  TEST_CHECK(shutdownBufferPool(bm));
+  TEST_CHECK(destroyPageFile(TEST_PAGE_FILE));
+  free(bm);
+
+  TEST_DONE();
+}
+
+// ************************************************************
+void
+testOptimisticReads (void)
+{
+  BM_BufferPool *bm = MAKE_POOL();
+  BM_PoolOptions opts;
+  BM_PageHandle h;
+  BM_PoolStats stats;
+  pthread_t workers[NUM_THREADS];
+  WorkerArgs args[NUM_THREADS];
+  char buf[PAGE_SIZE];
+  int value, i, errors = 0;
+
+  testName = "reading pages optimistically without pinning them";
+
+  createStampedFile(TEST_PAGE_FILE, 64);
+  initPoolOptions(&opts);
+  opts.threadSafe = true;
+  TEST_CHECK(initBufferPoolWithOptions(bm, TEST_PAGE_FILE, 4, RS_LRU, NULL, &opts));
+
+  // a resident page is copied without a pin
+  TEST_CHECK(pinPage(bm, &h, 2));
+  TEST_CHECK(unpinPage(bm, &h));
+  TEST_CHECK(readPageOptimistic(bm, 2, (char *) &value, 0, sizeof(int)));
+  ASSERT_EQUALS_INT(2, value, "resident page read");
+  getPoolStats(bm, &stats);
+  ASSERT_EQUALS_LONG(1, stats.optimisticReads, "read without a pin");
+  ASSERT_EQUALS_LONG(0, stats.optimisticFallbacks, "no fallback");
+  ASSERT_EQUALS_LONG(1, stats.misses + stats.hits, "optimistic read is not a pin");
+
+  // a missing page falls back to a pin, which loads it
+  TEST_CHECK(readPageOptimistic(bm, 9, buf, 0, PAGE_SIZE));
+  ASSERT_EQUALS_INT(9, *((int *) buf), "missing page read through a pin");
+  getPoolStats(bm, &stats);
+  ASSERT_EQUALS_LONG(1, stats.optimisticFallbacks, "fell back once");
+  TEST_CHECK(readPageOptimistic(bm, 9, (char *) &value, 0, sizeof(int)));
+  ASSERT_EQUALS_INT(9, value, "page resident after the fallback");
+
+  // changes made through a pin are seen once it is released
+  TEST_CHECK(pinPage(bm, &h, 2));
+  *((int *) h.data) = 200;
+  TEST_CHECK(markDirty(bm, &h));
+  TEST_CHECK(unpinPage(bm, &h));
+  TEST_CHECK(readPageOptimistic(bm, 2, (char *) &value, 0, sizeof(int)));
+  ASSERT_EQUALS_INT(200, value, "dirtied page read");
+  *((int *) buf) = 2;
+  TEST_CHECK(pinPage(bm, &h, 2));
+  memcpy(h.data, buf, sizeof(int));
+  TEST_CHECK(markDirty(bm, &h));
+  TEST_CHECK(unpinPage(bm, &h));
+
+  ASSERT_EQUALS_INT(RC_IM_KEY_NOT_FOUND, readPageOptimistic(bm, 2, buf, PAGE_SIZE - 2, 4), "range past the page rejected");
+  ASSERT_EQUALS_INT(RC_IM_KEY_NOT_FOUND, readPageOptimistic(bm, -1, buf, 0, 4), "negative page rejected");
+
+  // readers racing with evictions and resizes only ever see the page they asked for
+  started = 0;
+  for (i = 0; i < NUM_THREADS; i++)
+    {
+      args[i].bm = bm;
+      args[i].seed = 7 * (i + 1);
+      args[i].numOps = 4000;
+      args[i].numPages = 64;
+      args[i].errors = 0;
+      pthread_create(&workers[i], NULL, (i % 2 == 0) ? readRandomPages : pinRandomPages, &args[i]);
+    }
+  pthread_mutex_lock(&startLatch);
+  started = 1;
+  pthread_cond_broadcast(&startCond);
+  pthread_mutex_unlock(&startLatch);
+  for (i = 0; i < 20; i++)
+    {
+      RC rc = resizeBufferPool(bm, (i % 2 == 0) ? 32 : 6);
+      if (rc != RC_OK && rc != RC_PINNED_PAGES_IN_BUFFER)
+        errors++;
+    }
+  for (i = 0; i < NUM_THREADS; i++)
+    {
+      pthread_join(workers[i], NULL);
+      errors += args[i].errors;
+    }
+  ASSERT_EQUALS_INT(0, errors, "every optimistic read returned the requested page");
+  getPoolStats(bm, &stats);
+  ASSERT_TRUE(stats.optimisticReads > 0, "some reads served without a pin");
+
+  // readers racing with writers under the exclusive latch never copy a half-written page
+  errors = 0;
+  started = 0;
+  for (i = 0; i < NUM_THREADS; i++)
+    {
+      args[i].bm = bm;
+      args[i].seed = 11 * (i + 1);
+      args[i].numOps = 4000;
+      args[i].numPages = 2;
+      args[i].firstPage = (i % 2 == 0);
+      args[i].errors = 0;
+      pthread_create(&workers[i], NULL, (i % 2 == 0) ? latchedReadWrite : readWordsOptimistic, &args[i]);
+    }
+  pthread_mutex_lock(&startLatch);
+  started = 1;
+  pthread_cond_broadcast(&startCond);
+  pthread_mutex_unlock(&startLatch);
+  for (i = 0; i < NUM_THREADS; i++)
+    {
+      pthread_join(workers[i], NULL);
+      errors += args[i].errors;
+    }
+  ASSERT_EQUALS_INT(0, errors, "no copy mixed two writes");
+
+  TEST_CHECK(shutdownBufferPool(bm));
+  TEST_CHECK(destroyPageFile(TEST_PAGE_FILE));
+  free(bm);
+
+  TEST_DONE();
+}
+
+// ************************************************************
+void
+testFrameArena (void)
+{
+  BM_BufferPool *bm = MAKE_POOL();
+  BM_PoolOptions opts;
+  BM_PageHandle h;
+  BM_PoolStats stats;
+  long arenaBytes;
+  int i;
+
+  testName = "frame memory in a huge page aligned arena";
+
+  createStampedFile(TEST_PAGE_FILE, 800);
+  initPoolOptions(&opts);
+  opts.hugePages = true;
+
+  // small pools are not worth a huge page
+  TEST_CHECK(initBufferPoolWithOptions(bm, TEST_PAGE_FILE, 10, RS_FIFO, NULL, &opts));
+  getPoolStats(bm, &stats);
+  ASSERT_EQUALS_LONG(10 * PAGE_SIZE, stats.arenaBytes, "small pool maps its frames only");
+  ASSERT_EQUALS_LONG(0, stats.hugePageBytes, "no huge pages for a small pool");
+  TEST_CHECK(shutdownBufferPool(bm));
+
+  // larger pools are rounded up to whole huge pages; the kernel may not support them
+  TEST_CHECK(initBufferPoolWithOptions(bm, TEST_PAGE_FILE, 600, RS_LRU, NULL, &opts));
+  getPoolStats(bm, &stats);
+  arenaBytes = stats.arenaBytes;
+  ASSERT_EQUALS_LONG(2 * 2 * 1024 * 1024, arenaBytes, "arena rounded to huge pages");
+  ASSERT_TRUE(stats.hugePageBytes == 0 || stats.hugePageBytes == arenaBytes, "whole arena advised or none");
+  for (i = 0; i < 600; i++)
+    {
+      TEST_CHECK(pinPage(bm, &h, i));
+      if (*((int *) h.data) != i || (uintptr_t) h.data % PAGE_SIZE != 0)
+        break;
+      TEST_CHECK(unpinPage(bm, &h));
+    }
+  ASSERT_EQUALS_INT(600, i, "every frame holds its page on an aligned slot");
+
+  // growing uses the slots left over by the rounding, shrinking hands slots back
+  TEST_CHECK(resizeBufferPool(bm, 700));
+  TEST_CHECK(resizeBufferPool(bm, 100));
+  TEST_CHECK(resizeBufferPool(bm, 1024));
+  getPoolStats(bm, &stats);
+  ASSERT_EQUALS_LONG(arenaBytes, stats.arenaBytes, "resizes within the arena map nothing");
+  TEST_CHECK(resizeBufferPool(bm, 1025));
+  getPoolStats(bm, &stats);
+  ASSERT_TRUE(stats.arenaBytes > arenaBytes, "growing past the arena maps more");
+  for (i = 0; i < 800; i++)
+    {
+      TEST_CHECK(pinPage(bm, &h, i));
+      if (*((int *) h.data) != i)
+        break;
+      TEST_CHECK(unpinPage(bm, &h));
+    }
+  ASSERT_EQUALS_INT(800, i, "pages intact after the resizes");
+  TEST_CHECK(shutdownBufferPool(bm));
+
+  // explicit huge pages fall back to ordinary ones when none are reserved
+  opts.hugeTlb = true;
+  TEST_CHECK(initBufferPoolWithOptions(bm, TEST_PAGE_FILE, 512, RS_CLOCK, NULL, &opts));
+  TEST_CHECK(pinPage(bm, &h, 5));
+  ASSERT_EQUALS_INT(5, *((int *) h.data), "pool works with or without hugetlb pages");
+  TEST_CHECK(unpinPage(bm, &h));
+  TEST_CHECK(shutdownBufferPool(bm));
+
+  // without huge pages the arena is exactly the frames
+  opts.hugePages = false;
+  TEST_CHECK(initBufferPoolWithOptions(bm, TEST_PAGE_FILE, 600, RS_LRU, NULL, &opts));
+  getPoolStats(bm, &stats);
+  ASSERT_EQUALS_LONG(600 * PAGE_SIZE, stats.arenaBytes, "unrounded arena");
+  ASSERT_EQUALS_LONG(0, stats.hugePageBytes, "huge pages off");
+  TEST_CHECK(shutdownBufferPool(bm));
+
+  TEST_CHECK(destroyPageFile(TEST_PAGE_FILE));
+  free(bm);
+
+  TEST_DONE();
+}
+
+// ************************************************************
+void
+testSyncScans (void)
+{
+  BM_BufferPool *bm = MAKE_POOL();
+  BM_PageHandle ha, hb;
+  BM_AccessRing *ringA = createAccessRing(4);
+  BM_AccessRing *ringB = createAccessRing(4);
+  BM_SyncScan *a, *b;
+  int seen[20];
+  PageNumber p, ahead[10];
+  int i, numSeen = 0;
+
+  testName = "concurrent scans share a position and wrap around";
+
+  createStampedFile(TEST_PAGE_FILE, 20);
+  TEST_CHECK(initBufferPool(bm, TEST_PAGE_FILE, 8, RS_LRU, NULL));
+  memset(seen, 0, sizeof(seen));
+
+  // a lone scan starts at the first page
+  a = startSyncScan(bm, 0, 20);
+  for (i = 0; i < 7; i++)
+    {
+      p = nextSyncScanPage(a);
+      ASSERT_EQUALS_INT(i, p, "lone scan in page order");
+      TEST_CHECK(pinPageWithRing(bm, &ha, p, ringA));
+      TEST_CHECK(unpinPage(bm, &ha));
+    }
+
+  // a second scan joins at the first one's page, both then ask for the same pages
+  b = startSyncScan(bm, 0, 20);
+  p = nextSyncScanPage(b);
+  ASSERT_EQUALS_INT(6, p, "joined at the current page");
+  seen[p]++;
+  numSeen++;
+  TEST_CHECK(pinPageWithRing(bm, &hb, p, ringB));
+  TEST_CHECK(unpinPage(bm, &hb));
+  while ((p = nextSyncScanPage(a)) != NO_PAGE)
+    {
+      TEST_CHECK(pinPageWithRing(bm, &ha, p, ringA));
+      TEST_CHECK(unpinPage(bm, &ha));
+      p = nextSyncScanPage(b);
+      seen[p]++;
+      numSeen++;
+      TEST_CHECK(pinPageWithRing(bm, &hb, p, ringB));
+      ASSERT_EQUALS_INT(p, *((int *) hb.data), "scan page content");
+      TEST_CHECK(unpinPage(bm, &hb));
+    }
+  ASSERT_EQUALS_INT(20, getNumReadIO(bm), "pages read once for both scans");
+
+  // the joined scan wraps around to the pages it missed
+  while ((p = nextSyncScanPage(b)) != NO_PAGE)
+    {
+      ASSERT_TRUE(p < 6, "wrapped to the start");
+      seen[p]++;
+      numSeen++;
+    }
+  ASSERT_EQUALS_INT(20, numSeen, "every page once");
+  for (i = 0; i < 20; i++)
+    ASSERT_EQUALS_INT(1, seen[i], "no page twice");
+
+  // with every scan gone the next one starts over
+  endSyncScan(a);
+  endSyncScan(b);
+  a = startSyncScan(bm, 0, 20);
+  ASSERT_EQUALS_INT(0, nextSyncScanPage(a), "fresh scan at the first page");
+  endSyncScan(a);
+
+  // a position outside the range is not joined
+  a = startSyncScan(bm, 10, 20);
+  for (i = 0; i < 5; i++)
+    nextSyncScanPage(a);
+  b = startSyncScan(bm, 0, 5);
+  ASSERT_EQUALS_INT(0, nextSyncScanPage(b), "other range starts at its first page");
+  endSyncScan(a);
+  endSyncScan(b);
+
+  // peeking shows a joined scan's pages in the order it returns them, wrapping at the end
+  a = startSyncScan(bm, 10, 20);
+  for (i = 0; i < 5; i++)
+    nextSyncScanPage(a);
+  b = startSyncScan(bm, 12, 20);
+  ASSERT_EQUALS_INT(4, peekSyncScanPages(b, ahead, 4), "peek up to the asked number");
+  ASSERT_EQUALS_INT(14, ahead[0], "peek starts at the joined page");
+  ASSERT_EQUALS_INT(17, ahead[3], "peek in page order");
+  ASSERT_EQUALS_INT(8, peekSyncScanPages(b, ahead, 10), "peek stops at the pages left");
+  ASSERT_EQUALS_INT(19, ahead[5], "peek reaches the end of the range");
+  ASSERT_EQUALS_INT(12, ahead[6], "peek wraps to the first page");
+  ASSERT_EQUALS_INT(14, nextSyncScanPage(b), "peeking does not advance the scan");
+  endSyncScan(a);
+  endSyncScan(b);
+
+  TEST_CHECK(shutdownBufferPool(bm));
+  TEST_CHECK(destroyPageFile(TEST_PAGE_FILE));
+  freeAccessRing(ringA);
+  freeAccessRing(ringB);
+  free(bm);
+
+  TEST_DONE();
+}
+
+// ************************************************************
+void
+testGClock (void)
+{
+  BM_BufferPool *bm = MAKE_POOL();
+  BM_PageHandle h;
+  ReplacementStrategy strategies[] = {RS_CLOCK, RS_GCLOCK};
+  int s, i;
+
+  testName = "GCLOCK usage counters keep frequently hit pages";
+
+  createStampedFile(TEST_PAGE_FILE, 64);
+
+  // page 0 is hit three times and page 1 once before three new pages come in:
+  // CLOCK only remembers that both were hit, GCLOCK how often
+  for (s = 0; s < 2; s++)
+    {
+      TEST_CHECK(initBufferPool(bm, TEST_PAGE_FILE, 3, strategies[s], NULL));
+      for (i = 0; i < 3; i++)
+        {
+          TEST_CHECK(pinPage(bm, &h, i));
+          TEST_CHECK(unpinPage(bm, &h));
+        }
+      for (i = 0; i < 3; i++)
+        {
+          TEST_CHECK(pinPage(bm, &h, 0));
+          TEST_CHECK(unpinPage(bm, &h));
+        }
+      TEST_CHECK(pinPage(bm, &h, 1));
+      TEST_CHECK(unpinPage(bm, &h));
+      for (i = 3; i < 6; i++)
+        {
+          TEST_CHECK(pinPage(bm, &h, i));
+          TEST_CHECK(unpinPage(bm, &h));
+        }
+      if (strategies[s] == RS_GCLOCK)
+        ASSERT_TRUE(isResident(bm, 0), "GCLOCK keeps the page hit most");
+      else
+        ASSERT_TRUE(!isResident(bm, 0), "CLOCK evicts the page hit most");
+      ASSERT_TRUE(!isResident(bm, 1) && !isResident(bm, 2), "pages hit less are evicted");
+      TEST_CHECK(shutdownBufferPool(bm));
+    }
+
+  // the counter saturates, so a page that stops being hit ages out
+  TEST_CHECK(initBufferPool(bm, TEST_PAGE_FILE, 3, RS_GCLOCK, NULL));
+  for (i = 0; i < 100; i++)
+    {
+      TEST_CHECK(pinPage(bm, &h, 0));
+      TEST_CHECK(unpinPage(bm, &h));
+    }
+  for (i = 1; i <= 3 * GCLOCK_MAX_USAGE && isResident(bm, 0); i++)
+    {
+      TEST_CHECK(pinPage(bm, &h, i));
+      TEST_CHECK(unpinPage(bm, &h));
+    }
+  ASSERT_TRUE(!isResident(bm, 0), "unused page evicted after a bounded number of sweeps");
+  ASSERT_TRUE(i > GCLOCK_MAX_USAGE, "but only after several sweeps");
+
+  // a hit page stays while all frames but one are pinned, the unpinned one is reused
+  TEST_CHECK(pinPage(bm, &h, 50));
+  TEST_CHECK(pinPage(bm, &h, 51));
+  TEST_CHECK(pinPage(bm, &h, 52));
+  ASSERT_EQUALS_INT(RC_IM_NO_MORE_ENTRIES, pinPage(bm, &h, 53), "no victim while every frame is pinned");
+  h.pageNum = 52;
+  TEST_CHECK(unpinPage(bm, &h));
+  TEST_CHECK(pinPage(bm, &h, 53));
+  ASSERT_EQUALS_INT(53, *((int *) h.data), "page read into the unpinned frame");
+  TEST_CHECK(unpinPage(bm, &h));
+  for (i = 50; i < 52; i++)
+    {
+      h.pageNum = i;
+      TEST_CHECK(unpinPage(bm, &h));
+    }
+
+  TEST_CHECK(shutdownBufferPool(bm));
+  TEST_CHECK(destroyPageFile(TEST_PAGE_FILE));
+  free(bm);
+
+  TEST_DONE();
+}
+
+// ************************************************************
+void
+testWriteBehind (void)
+{
+  BM_BufferPool *bm = MAKE_POOL();
+  BM_PoolOptions opts;
+  BM_PoolStats stats;
+  BM_PageHandle h;
+  SM_FileHandle fh;
+  char page[PAGE_SIZE];
+  pthread_t workers[NUM_THREADS];
+  WorkerArgs args[NUM_THREADS];
+  int i, t;
+
+  testName = "dirty victims go to a write-behind queue";
+
+  createStampedFile(TEST_PAGE_FILE, NUM_THREADS * 16);
+  initPoolOptions(&opts);
+  opts.writeBehind = true;
+  opts.writeBehindPages = 8;
+  opts.bgWriterDelayMs = 10000; // only a half full queue wakes the writer
+  TEST_CHECK(initBufferPoolWithOptions(bm, TEST_PAGE_FILE, 3, RS_FIFO, NULL, &opts));
+
+  // three dirty pages are evicted without a write
+  for (i = 0; i < 3; i++)
+    {
+      TEST_CHECK(pinPage(bm, &h, i));
+      ((int *) h.data)[1] = 100 + i;
+      TEST_CHECK(markDirty(bm, &h));
+      TEST_CHECK(unpinPage(bm, &h));
+    }
+  for (i = 3; i < 6; i++)
+    {
+      TEST_CHECK(pinPage(bm, &h, i));
+      TEST_CHECK(unpinPage(bm, &h));
+    }
+  getPoolStats(bm, &stats);
+  ASSERT_EQUALS_LONG(3, stats.dirtyEvictions, "three dirty evictions");
+  ASSERT_EQUALS_LONG(3, stats.queuedWrites, "all of them queued");
+  ASSERT_EQUALS_INT(0, getNumWriteIO(bm), "no miss waited for a write");
+
+  // a queued page comes back from the queue, not from the stale copy on disk
+  TEST_CHECK(pinPage(bm, &h, 0));
+  ASSERT_EQUALS_INT(100, ((int *) h.data)[1], "queued content served");
+  TEST_CHECK(unpinPage(bm, &h));
+  getPoolStats(bm, &stats);
+  ASSERT_EQUALS_LONG(1, stats.queueHits, "served from the queue");
+  ASSERT_EQUALS_INT(6, getNumReadIO(bm), "without a read");
+
+  // a flush writes the queue as one batch, and the page taken back with its frame
+  TEST_CHECK(forceFlushPool(bm));
+  ASSERT_EQUALS_INT(3, getNumWriteIO(bm), "every page written once");
+  TEST_CHECK(openPageFile(TEST_PAGE_FILE, &fh));
+  for (i = 0; i < 3; i++)
+    {
+      TEST_CHECK(readBlock(i, &fh, page));
+      ASSERT_EQUALS_INT(100 + i, ((int *) page)[1], "queued page on disk");
+    }
+  TEST_CHECK(closePageFile(&fh));
+  TEST_CHECK(shutdownBufferPool(bm));
+  TEST_CHECK(destroyPageFile(TEST_PAGE_FILE));
+
+  // writers on their own pages keep a small queue full; every last write reaches the disk
+  createStampedFile(TEST_PAGE_FILE, NUM_THREADS * 16);
+  opts.bgWriterDelayMs = 1;
+  TEST_CHECK(initBufferPoolWithOptions(bm, TEST_PAGE_FILE, NUM_THREADS * 2, RS_CLOCK, NULL, &opts));
+  started = 0;
+  for (t = 0; t < NUM_THREADS; t++)
+    {
+      args[t].bm = bm;
+      args[t].seed = t + 1;
+      args[t].numOps = 20000;
+      args[t].numPages = 16;
+      args[t].firstPage = t * 16;
+      args[t].errors = 0;
+      pthread_create(&workers[t], NULL, writeOwnPages, &args[t]);
+    }
+  pthread_mutex_lock(&startLatch);
+  started = 1;
+  pthread_cond_broadcast(&startCond);
+  pthread_mutex_unlock(&startLatch);
+  for (t = 0; t < NUM_THREADS; t++)
+    {
+      pthread_join(workers[t], NULL);
+      ASSERT_EQUALS_INT(0, args[t].errors, "every page read back with its last value");
+    }
+  getPoolStats(bm, &stats);
+  ASSERT_TRUE(stats.queuedWrites > 0, "dirty victims queued");
+  TEST_CHECK(shutdownBufferPool(bm));
+
+  TEST_CHECK(openPageFile(TEST_PAGE_FILE, &fh));
+  for (t = 0; t < NUM_THREADS; t++)
+    for (i = 0; i < 16; i++)
+      {
+        TEST_CHECK(readBlock(args[t].firstPage + i, &fh, page));
+        ASSERT_EQUALS_INT(args[t].lastValue[i], ((int *) page)[1], "last write on disk");
+      }
+  TEST_CHECK(closePageFile(&fh));
+
+  // a queued page that cannot be written fails the shutdown and keeps the handle for a retry
+  opts.bgWriterDelayMs = 10000;
+  TEST_CHECK(initBufferPoolWithOptions(bm, TEST_PAGE_FILE, 3, RS_FIFO, NULL, &opts));
+  for (i = 0; i < 6; i++)
+    {
+      TEST_CHECK(pinPage(bm, &h, i));
+      ((int *) h.data)[1] = 300 + i;
+      TEST_CHECK(markDirty(bm, &h));
+      TEST_CHECK(unpinPage(bm, &h));
+    }
+  ASSERT_TRUE(rename(TEST_PAGE_FILE, TEST_PAGE_FILE_2) == 0, "page file moved away");
+  ASSERT_TRUE(shutdownBufferPool(bm) != RC_OK, "unwritable queue fails the shutdown");
+  ASSERT_TRUE(bm->mgmtData != NULL, "handle still attached");
+  ASSERT_TRUE(rename(TEST_PAGE_FILE_2, TEST_PAGE_FILE) == 0, "page file moved back");
+  TEST_CHECK(shutdownBufferPool(bm));
+  TEST_CHECK(openPageFile(TEST_PAGE_FILE, &fh));
+  for (i = 0; i < 6; i++)
+    {
+      TEST_CHECK(readBlock(i, &fh, page));
+      ASSERT_EQUALS_INT(300 + i, ((int *) page)[1], "page written by the retry");
+    }
+  TEST_CHECK(closePageFile(&fh));
+
+  TEST_CHECK(destroyPageFile(TEST_PAGE_FILE));
+  free(bm);
+
+  TEST_DONE();
+}
+
+// ************************************************************
+void
+testAdaptiveStrategy (void)
+{
+  BM_BufferPool *bm = MAKE_POOL();
+  BM_PoolOptions opts;
+  BM_PoolStats stats;
+  BM_PageHandle h;
+  unsigned int seed = 5;
+  int i, cold = 0, errors = 0;
+
+  testName = "adaptive mode switches to a strategy that hits more";
+
+  createStampedFile(TEST_PAGE_FILE, 256);
+  initPoolOptions(&opts);
+  opts.adaptiveStrategy = true;
+  opts.adaptWindowPins = 256;
+  TEST_CHECK(initBufferPoolWithOptions(bm, TEST_PAGE_FILE, 8, RS_FIFO, NULL, &opts));
+
+  // a hot set that fits the pool, mixed with a cold cycle that flushes it out of FIFO
+  for (i = 0; i < 4000; i++)
+    {
+      PageNumber pageNum = (rand_r(&seed) % 5 != 0) ? rand_r(&seed) % 6 : 10 + cold++ % 200;
+
+      TEST_CHECK(pinPage(bm, &h, pageNum));
+      if (*((int *) h.data) != pageNum)
+        errors++;
+      TEST_CHECK(unpinPage(bm, &h));
+      if (i == 2000)
+        TEST_CHECK(resizeBufferPool(bm, 10));  // the shadows follow the new size
+    }
+  ASSERT_EQUALS_INT(0, errors, "every pin got its page");
+  getPoolStats(bm, &stats);
+  ASSERT_TRUE(stats.strategySwitches >= 1, "strategy switched");
+  ASSERT_TRUE(stats.strategy != RS_FIFO, "away from FIFO");
+  ASSERT_EQUALS_INT(RS_FIFO, bm->strategy, "the handle keeps the requested strategy");
+  TEST_CHECK(shutdownBufferPool(bm));
+
+  // without the option the strategy stays
+  TEST_CHECK(initBufferPool(bm, TEST_PAGE_FILE, 8, RS_FIFO, NULL));
+  for (i = 0; i < 4000; i++)
+    {
+      TEST_CHECK(pinPage(bm, &h, (i % 5 != 0) ? i % 6 : 10 + i % 200));
+      TEST_CHECK(unpinPage(bm, &h));
+    }
+  getPoolStats(bm, &stats);
+  ASSERT_EQUALS_LONG(0, stats.strategySwitches, "no switches");
+  ASSERT_EQUALS_INT(RS_FIFO, stats.strategy, "still FIFO");
+  TEST_CHECK(shutdownBufferPool(bm));
+
+  TEST_CHECK(destroyPageFile(TEST_PAGE_FILE));
+  free(bm);
+
+  TEST_DONE();
+}
+
+// ************************************************************
+void
+testCompressedCache (void)
+{
+  BM_BufferPool *bm = MAKE_POOL();
+  BM_PoolOptions opts;
+  BM_PoolStats stats;
+  BM_PageHandle h;
+  BM_PageHandle batch[8];
+  PageNumber pageNums[8];
+  pthread_t workers[NUM_THREADS];
+  WorkerArgs args[NUM_THREADS];
+  char noise[PAGE_SIZE];
+  unsigned int seed = 7;
+  int i, t, pass, errors = 0;
+
+  testName = "clean victims are served from the compressed cache";
+
+  createStampedFile(TEST_PAGE_FILE, 30);
+  initPoolOptions(&opts);
+  opts.compressedCache = true;
+  TEST_CHECK(initBufferPoolWithOptions(bm, TEST_PAGE_FILE, 10, RS_FIFO, NULL, &opts));
+
+  // the second pass finds every page it misses on in the cache
+  for (pass = 0; pass < 2; pass++)
+    for (i = 0; i < 30; i++)
+      {
+        TEST_CHECK(pinPage(bm, &h, i));
+        if (*((int *) h.data) != i)
+          errors++;
+        TEST_CHECK(unpinPage(bm, &h));
+      }
+  ASSERT_EQUALS_INT(0, errors, "every pin got its page");
+  ASSERT_EQUALS_INT(30, getNumReadIO(bm), "each page read once");
+  getPoolStats(bm, &stats);
+  ASSERT_EQUALS_LONG(30, stats.compressedHits, "second pass served from the cache");
+  ASSERT_TRUE(stats.compressedStores >= 50, "victims stored");
+  ASSERT_TRUE(stats.compressedBytes < 20 * PAGE_SIZE / 8, "stamped pages stored compressed");
+
+  // a dirty page that does not compress is written, then kept raw
+  for (i = 0; i < PAGE_SIZE; i++)
+    noise[i] = (char) rand_r(&seed);
+  TEST_CHECK(pinPage(bm, &h, 25));
+  memcpy(h.data, noise, PAGE_SIZE);
+  TEST_CHECK(markDirty(bm, &h));
+  TEST_CHECK(unpinPage(bm, &h));
+  for (i = 0; i < 10; i++)
+    {
+      TEST_CHECK(pinPage(bm, &h, i));
+      TEST_CHECK(unpinPage(bm, &h));
+    }
+  ASSERT_TRUE(!isResident(bm, 25), "noisy page evicted");
+  TEST_CHECK(pinPage(bm, &h, 25));
+  ASSERT_TRUE(memcmp(h.data, noise, PAGE_SIZE) == 0, "noisy page comes back unchanged");
+  TEST_CHECK(unpinPage(bm, &h));
+  ASSERT_EQUALS_INT(30, getNumReadIO(bm), "still no further reads");
+
+  // batched pins take their misses from the cache too
+  for (i = 0; i < 8; i++)
+    pageNums[i] = 10 + i;
+  TEST_CHECK(pinPages(bm, batch, pageNums, 8));
+  for (i = 0; i < 8; i++)
+    if (*((int *) batch[i].data) != 10 + i)
+      errors++;
+  TEST_CHECK(unpinPages(bm, batch, 8));
+  ASSERT_EQUALS_INT(0, errors, "batch got its pages");
+  ASSERT_EQUALS_INT(30, getNumReadIO(bm), "batch read nothing");
+  TEST_CHECK(shutdownBufferPool(bm));
+
+  // pages that do not compress overflow a small budget, oldest first
+  opts.compressedCacheBytes = 4 * PAGE_SIZE;
+  TEST_CHECK(initBufferPoolWithOptions(bm, TEST_PAGE_FILE, 4, RS_FIFO, NULL, &opts));
+  for (i = 0; i < 30; i++)
+    {
+      TEST_CHECK(pinPage(bm, &h, i));
+      *((int *) h.data) = i;
+      memcpy(h.data + sizeof(int), noise, PAGE_SIZE - sizeof(int));
+      TEST_CHECK(markDirty(bm, &h));
+      TEST_CHECK(unpinPage(bm, &h));
+    }
+  getPoolStats(bm, &stats);
+  ASSERT_TRUE(stats.compressedDrops > 0, "entries dropped");
+  ASSERT_TRUE(stats.compressedBytes <= 4 * PAGE_SIZE, "within budget");
+  TEST_CHECK(pinPage(bm, &h, 25));
+  ASSERT_EQUALS_INT(25, *((int *) h.data), "recent victim from the cache");
+  TEST_CHECK(unpinPage(bm, &h));
+  TEST_CHECK(pinPage(bm, &h, 0));
+  ASSERT_EQUALS_INT(0, *((int *) h.data), "dropped victim from disk");
+  TEST_CHECK(unpinPage(bm, &h));
+  getPoolStats(bm, &stats);
+  ASSERT_EQUALS_LONG(31, stats.readIO, "one read for the dropped page");
+  TEST_CHECK(shutdownBufferPool(bm));
+  TEST_CHECK(destroyPageFile(TEST_PAGE_FILE));
+
+  // concurrent writers evicting each other's pages never get an outdated copy back
+  createStampedFile(TEST_PAGE_FILE, NUM_THREADS * 16);
+  initPoolOptions(&opts);
+  opts.threadSafe = true;
+  opts.compressedCache = true;
+  TEST_CHECK(initBufferPoolWithOptions(bm, TEST_PAGE_FILE, NUM_THREADS * 2, RS_CLOCK, NULL, &opts));
+  started = 0;
+  for (t = 0; t < NUM_THREADS; t++)
+    {
+      args[t].bm = bm;
+      args[t].seed = t + 1;
+      args[t].numOps = 5000;
+      args[t].numPages = 16;
+      args[t].firstPage = t * 16;
+      args[t].errors = 0;
+      pthread_create(&workers[t], NULL, writeOwnPages, &args[t]);
+    }
+  pthread_mutex_lock(&startLatch);
+  started = 1;
+  pthread_cond_broadcast(&startCond);
+  pthread_mutex_unlock(&startLatch);
+  for (t = 0; t < NUM_THREADS; t++)
+    {
+      pthread_join(workers[t], NULL);
+      ASSERT_EQUALS_INT(0, args[t].errors, "every page read back with its last value");
+    }
+  getPoolStats(bm, &stats);
+  ASSERT_TRUE(stats.compressedHits > 0, "misses served from the cache");
+  TEST_CHECK(shutdownBufferPool(bm));
+
+  TEST_CHECK(destroyPageFile(TEST_PAGE_FILE));
+  free(bm);
+
+  TEST_DONE();
+}
+
+// ************************************************************
+void
+testPageLatches (void)
+{
+  BM_BufferPool *bm = MAKE_POOL();
+  BM_PoolOptions opts;
+  BM_PoolStats stats;
+  BM_PageHandle reader1, reader2;
+  pthread_t workers[NUM_THREADS];
+  WorkerArgs args[NUM_THREADS];
+  int *fixCounts;
+  int t;
+
+  testName = "shared and exclusive page latches";
+
+  createStampedFile(TEST_PAGE_FILE, 10);
+  initPoolOptions(&opts);
+  opts.threadSafe = true;
+  TEST_CHECK(initBufferPoolWithOptions(bm, TEST_PAGE_FILE, 8, RS_LRU, NULL, &opts));
+
+  // readers share a page without waiting
+  TEST_CHECK(pinPageShared(bm, &reader1, 2));
+  TEST_CHECK(pinPageShared(bm, &reader2, 2));
+  ASSERT_EQUALS_INT(BM_LATCH_SHARED, reader2.latchMode, "handle records the latch");
+  ASSERT_EQUALS_INT(RC_INVALID_INPUT, latchPage(bm, &reader2, BM_LATCH_SHARED), "one latch per handle");
+  getPoolStats(bm, &stats);
+  ASSERT_EQUALS_LONG(0, stats.latchWaits, "no reader waited");
+
+  // a writer waits until both readers are gone
+  started = 0;
+  args[0].bm = bm;
+  args[0].errors = 0;
+  args[0].numOps = 0;
+  pthread_create(&workers[0], NULL, latchOnePage, &args[0]);
+  pthread_mutex_lock(&startLatch);
+  started = 1;
+  pthread_cond_broadcast(&startCond);
+  pthread_mutex_unlock(&startLatch);
+  usleep(50000);
+  ASSERT_EQUALS_INT(0, args[0].numOps, "writer still waits for the readers");
+  TEST_CHECK(unpinPageRef(bm, &reader1));
+  TEST_CHECK(unlatchPage(bm, &reader2));
+  fixCounts = getFixCounts(bm);
+  ASSERT_TRUE(fixCounts[0] + fixCounts[1] + fixCounts[2] >= 1, "unlatching keeps the pin");
+  free(fixCounts);
+  pthread_join(workers[0], NULL);
+  ASSERT_EQUALS_INT(1, args[0].numOps, "writer got the page");
+  ASSERT_EQUALS_INT(0, args[0].errors, "writer saw the page");
+  TEST_CHECK(unpinPageRef(bm, &reader2));
+  getPoolStats(bm, &stats);
+  ASSERT_TRUE(stats.latchWaits >= 1, "the writer's wait counted");
+
+  // readers never see a page half changed by a writer
+  started = 0;
+  for (t = 0; t < NUM_THREADS; t++)
+    {
+      args[t].bm = bm;
+      args[t].seed = t + 1;
+      args[t].numOps = 5000;
+      args[t].numPages = 4;
+      args[t].firstPage = t % 2;  // odd workers write, even ones read
+      args[t].errors = 0;
+      pthread_create(&workers[t], NULL, latchedReadWrite, &args[t]);
+    }
+  pthread_mutex_lock(&startLatch);
+  started = 1;
+  pthread_cond_broadcast(&startCond);
+  pthread_mutex_unlock(&startLatch);
+  for (t = 0; t < NUM_THREADS; t++)
+    {
+      pthread_join(workers[t], NULL);
+      ASSERT_EQUALS_INT(0, args[t].errors, "every read saw a whole change");
+    }
+  TEST_CHECK(shutdownBufferPool(bm));
+
+  TEST_CHECK(destroyPageFile(TEST_PAGE_FILE));
+  free(bm);
+
+  TEST_DONE();
+}
+
+// ************************************************************
+void
+testScratchPages (void)
+{
+  BM_BufferPool *bm = MAKE_POOL();
+  BM_PoolStats stats;
+  BM_PageHandle h, held;
+  SM_FileHandle fh;
+  PageNumber scratch[12];
+  int i, writes;
+
+  testName = "scratch pages spilled to a temp file";
+
+  createStampedFile(TEST_PAGE_FILE, 4);
+  TEST_CHECK(initBufferPool(bm, TEST_PAGE_FILE, 4, RS_LRU, NULL));
+
+  // three times as many scratch pages as frames: most of them spill
+  for (i = 0; i < 12; i++)
+    {
+      TEST_CHECK(allocScratchPage(bm, &h));
+      ASSERT_EQUALS_INT(0, *((int *) h.data + 1), "new scratch page is zeroed");
+      *((int *) h.data) = 1000 + i;
+      scratch[i] = h.pageNum;
+      TEST_CHECK(markDirty(bm, &h));
+      TEST_CHECK(unpinPage(bm, &h));
+    }
+  getPoolStats(bm, &stats);
+  ASSERT_EQUALS_LONG(12, stats.scratchPages, "scratch pages allocated");
+  ASSERT_TRUE(stats.scratchSpills >= 8, "evicted scratch pages spilled");
+
+  for (i = 0; i < 12; i++)
+    {
+      TEST_CHECK(pinScratchPage(bm, &h, scratch[i]));
+      ASSERT_EQUALS_INT(1000 + i, *((int *) h.data), "scratch page read back");
+      TEST_CHECK(unpinPageRef(bm, &h));
+    }
+
+  // a flush or checkpoint never writes scratch pages, and the page file never sees them
+  TEST_CHECK(pinScratchPage(bm, &held, scratch[0]));
+  TEST_CHECK(markDirtyRef(bm, &held));
+  writes = getNumWriteIO(bm);
+  TEST_CHECK(forcePageRef(bm, &held));
+  TEST_CHECK(forceFlushPool(bm));
+  TEST_CHECK(checkpointPool(bm, 1, 0));
+  ASSERT_EQUALS_INT(writes, getNumWriteIO(bm), "scratch pages not flushed");
+  TEST_CHECK(openPageFile(TEST_PAGE_FILE, &fh));
+  ASSERT_EQUALS_INT(4, fh.totalNumPages, "page file did not grow");
+  TEST_CHECK(closePageFile(&fh));
+  TEST_CHECK(pinPage(bm, &h, 2));
+  ASSERT_EQUALS_INT(2, *((int *) h.data), "page file pages unchanged");
+  TEST_CHECK(unpinPageRef(bm, &h));
+
+  // freeing discards the page and hands its number out again, zeroed
+  ASSERT_EQUALS_INT(RC_PINNED_PAGES_IN_BUFFER, freeScratchPage(bm, scratch[0]), "pinned scratch page kept");
+  TEST_CHECK(unpinPageRef(bm, &held));
+  TEST_CHECK(freeScratchPage(bm, scratch[0]));
+  TEST_CHECK(freeScratchPage(bm, scratch[1]));  // spilled and not resident
+  ASSERT_EQUALS_INT(RC_READ_NON_EXISTING_PAGE, freeScratchPage(bm, scratch[1]), "freed only once");
+  ASSERT_EQUALS_INT(RC_READ_NON_EXISTING_PAGE, pinScratchPage(bm, &h, scratch[1]), "freed page gone");
+  ASSERT_EQUALS_INT(RC_READ_NON_EXISTING_PAGE, pinScratchPage(bm, &h, 99), "never allocated");
+  TEST_CHECK(allocScratchPage(bm, &h));
+  ASSERT_TRUE(h.pageNum == scratch[0] || h.pageNum == scratch[1], "freed number reused");
+  ASSERT_EQUALS_INT(0, *((int *) h.data), "reused page is zeroed");
+  TEST_CHECK(unpinPageRef(bm, &h));
+  getPoolStats(bm, &stats);
+  ASSERT_EQUALS_LONG(11, stats.scratchPages, "two freed, one allocated");
+
+  TEST_CHECK(shutdownBufferPool(bm));
+  TEST_CHECK(destroyPageFile(TEST_PAGE_FILE));
+  free(bm);
+
+  TEST_DONE();
+}
+
+// ************************************************************
+void
+testPinCache (void)
+{
+  BM_BufferPool *bm = MAKE_POOL();
+  BM_PoolOptions opts;
+  BM_PoolStats stats;
+  BM_PageHandle h, batch[4];
+  PageNumber others[] = {1, 2, 3, 4};
+  pthread_t workers[NUM_THREADS];
+  WorkerArgs args[NUM_THREADS];
+  long cacheHits;
+  int i, t, reads;
+
+  testName = "per-thread pin cache";
+
+  createStampedFile(TEST_PAGE_FILE, 16);
+  initPoolOptions(&opts);
+  opts.threadSafe = true;
+  opts.pinCache = true;
+  TEST_CHECK(initBufferPoolWithOptions(bm, TEST_PAGE_FILE, 4, RS_CLOCK, NULL, &opts));
+
+  // after the first pin, re-pins of the page skip the page table
+  for (i = 0; i < 10; i++)
+    {
+      TEST_CHECK(pinPage(bm, &h, 0));
+      ASSERT_EQUALS_INT(0, *((int *) h.data), "cached pin sees its page");
+      TEST_CHECK(unpinPageRef(bm, &h));
+    }
+  getPoolStats(bm, &stats);
+  ASSERT_EQUALS_LONG(9, stats.pinCacheHits, "re-pins served by the pin cache");
+
+  // evicting the page makes its entry stale; batch pins do not touch this thread's cache
+  TEST_CHECK(pinPages(bm, batch, others, 4));
+  TEST_CHECK(unpinPages(bm, batch, 4));
+  ASSERT_TRUE(!isResident(bm, 0), "page evicted by the batch");
+  reads = getNumReadIO(bm);
+  TEST_CHECK(pinPage(bm, &h, 0));
+  ASSERT_EQUALS_INT(0, *((int *) h.data), "evicted page read again");
+  ASSERT_EQUALS_INT(reads + 1, getNumReadIO(bm), "stale entry not used");
+  TEST_CHECK(unpinPageRef(bm, &h));
+  getPoolStats(bm, &stats);
+  ASSERT_EQUALS_LONG(9, stats.pinCacheHits, "no pin cache hit on the evicted page");
+  cacheHits = stats.pinCacheHits;
+
+  // threads pinning and evicting the same few pages never get the wrong one
+  started = 0;
+  for (t = 0; t < NUM_THREADS; t++)
+    {
+      args[t].bm = bm;
+      args[t].seed = t + 1;
+      args[t].numOps = 5000;
+      args[t].numPages = 6;
+      args[t].errors = 0;
+      pthread_create(&workers[t], NULL, pinRandomPages, &args[t]);
+    }
+  pthread_mutex_lock(&startLatch);
+  started = 1;
+  pthread_cond_broadcast(&startCond);
+  pthread_mutex_unlock(&startLatch);
+  for (t = 0; t < NUM_THREADS; t++)
+    {
+      pthread_join(workers[t], NULL);
+      ASSERT_EQUALS_INT(0, args[t].errors, "every pin got its own page");
+    }
+  getPoolStats(bm, &stats);
+  ASSERT_TRUE(stats.pinCacheHits > cacheHits, "workers hit their pin caches");
+  TEST_CHECK(shutdownBufferPool(bm));
+
+  // under LRU a pin cache hit only marks the frame; the next victim search moves it to the tail
+  TEST_CHECK(initBufferPoolWithOptions(bm, TEST_PAGE_FILE, 3, RS_LRU, NULL, &opts));
+  for (i = 0; i < 3; i++)
+    {
+      TEST_CHECK(pinPage(bm, &h, i));
+      TEST_CHECK(unpinPageRef(bm, &h));
+    }
+  TEST_CHECK(pinPage(bm, &h, 0));
+  TEST_CHECK(unpinPageRef(bm, &h));
+  getPoolStats(bm, &stats);
+  ASSERT_EQUALS_LONG(1, stats.pinCacheHits, "LRU re-pin served by the pin cache");
+  TEST_CHECK(pinPage(bm, &h, 3));
+  TEST_CHECK(unpinPageRef(bm, &h));
+  ASSERT_TRUE(isResident(bm, 0), "cache hit kept the page");
+  ASSERT_TRUE(!isResident(bm, 1), "least recently used page evicted");
+  TEST_CHECK(shutdownBufferPool(bm));
+
+  TEST_CHECK(destroyPageFile(TEST_PAGE_FILE));
+  free(bm);
+
+  TEST_DONE();
+}
+
+// ************************************************************
+void
+testMemoryGovernor (void)
+{
+  BM_BufferPool *a = MAKE_POOL();
+  BM_BufferPool *b = MAKE_POOL();
+  BM_BufferPool *c = MAKE_POOL();
+  BM_PoolStats statsA, statsB;
+  BM_PageHandle h;
+  int i, round;
+
+  testName = "memory governor shares one budget between pools";
+
+  createStampedFile(TEST_PAGE_FILE, 40);
+  createStampedFile(TEST_PAGE_FILE_2, 4);
+  TEST_CHECK(initBufferPool(a, TEST_PAGE_FILE, 16, RS_LRU, NULL));
+  TEST_CHECK(initBufferPool(b, TEST_PAGE_FILE_2, 16, RS_LRU, NULL));
+  ASSERT_EQUALS_INT(RC_INVALID_INPUT, setMemoryBudget(-1), "negative budget rejected");
+  TEST_CHECK(setMemoryBudget(32 * PAGE_SIZE));
+
+  // a cycles through more pages than it holds and keeps missing on pages it just evicted;
+  // b re-pins a few pages and would gain nothing from more frames
+  for (round = 0; round < 2; round++)
+    for (i = 0; i < 40; i++)
+      {
+        TEST_CHECK(pinPage(a, &h, i));
+        TEST_CHECK(unpinPage(a, &h));
+        TEST_CHECK(pinPage(b, &h, i % 4));
+        TEST_CHECK(unpinPage(b, &h));
+      }
+  getPoolStats(a, &statsA);
+  getPoolStats(b, &statsB);
+  ASSERT_TRUE(statsA.ghostHits > 0, "a missed on recently evicted pages");
+  ASSERT_EQUALS_LONG(0, statsB.ghostHits, "b never did");
+
+  // the budget is used up, so b's frames above its minimum move to a
+  TEST_CHECK(rebalancePools());
+  getPoolStats(a, &statsA);
+  getPoolStats(b, &statsB);
+  ASSERT_EQUALS_INT(24, statsA.numFrames, "a grew");
+  ASSERT_EQUALS_INT(8, statsB.numFrames, "b shrank to its minimum");
+  TEST_CHECK(rebalancePools());  // no ghost hits in the new window: nothing moves
+  getPoolStats(a, &statsA);
+  ASSERT_EQUALS_INT(24, statsA.numFrames, "no gain, no move");
+  TEST_CHECK(pinPage(a, &h, 39));
+  ASSERT_EQUALS_INT(39, *((int *) h.data), "a's pages intact");
+  TEST_CHECK(unpinPage(a, &h));
+
+  // a smaller budget shrinks the pools, but never below their minimums
+  TEST_CHECK(setMemoryBudget(24 * PAGE_SIZE));
+  getPoolStats(a, &statsA);
+  getPoolStats(b, &statsB);
+  ASSERT_EQUALS_INT(24, statsA.numFrames + statsB.numFrames, "pools fit the budget");
+  TEST_CHECK(setMemoryBudget(8 * PAGE_SIZE));
+  getPoolStats(a, &statsA);
+  getPoolStats(b, &statsB);
+  ASSERT_EQUALS_INT(8, statsA.numFrames, "a kept its minimum");
+  ASSERT_EQUALS_INT(8, statsB.numFrames, "b kept its minimum");
+
+  // a raised minimum grows the pool; a new pool is admitted at its minimum
+  TEST_CHECK(setPoolMinimum(b, 12));
+  getPoolStats(b, &statsB);
+  ASSERT_EQUALS_INT(12, statsB.numFrames, "b grew to its new minimum");
+  TEST_CHECK(initBufferPool(c, TEST_PAGE_FILE_2, 16, RS_LRU, NULL));
+  ASSERT_EQUALS_INT(GOVERNOR_MIN_PAGES, c->numPages, "new pool admitted at its minimum");
+  ASSERT_EQUALS_INT(RC_INVALID_INPUT, setPoolMinimum(c, 0), "minimum of at least one frame");
+
+  TEST_CHECK(setMemoryBudget(0));
+  TEST_CHECK(shutdownBufferPool(c));
+  TEST_CHECK(shutdownBufferPool(b));
+  TEST_CHECK(shutdownBufferPool(a));
+  TEST_CHECK(destroyPageFile(TEST_PAGE_FILE));
+  TEST_CHECK(destroyPageFile(TEST_PAGE_FILE_2));
+  free(a);
+  free(b);
+  free(c);
+
+  TEST_DONE();
+}
+
+// ************************************************************
+void *
+pinSamePage (void *arg)
+{
+  WorkerArgs *args = (WorkerArgs *) arg;
+  BM_PageHandle h;
+
+  waitForStart();
+  if (pinPage(args->bm, &h, 3) != RC_OK || *((int *) h.data) != 3)
+    args->errors++;
+  else
+    unpinPage(args->bm, &h);
+
+  return NULL;
+}
+
+// ************************************************************
+void *
+pinRandomPages (void *arg)
+{
+  WorkerArgs *args = (WorkerArgs *) arg;
+  BM_PageHandle h;
+  int i;
+
+  waitForStart();
+  for (i = 0; i < args->numOps; i++)
+    {
+      int pageNum = rand_r(&args->seed) % args->numPages;
+      RC rc = pinPage(args->bm, &h, pageNum);
+
+      // every frame may be pinned by the other workers for a moment
+      if (rc == RC_IM_NO_MORE_ENTRIES)
+        continue;
+      if (rc != RC_OK || *((int *) h.data) != pageNum)
+        args->errors++;
+      if (rc == RC_OK)
+        unpinPage(args->bm, &h);
+    }
+
+  return NULL;
+}
+
+// ************************************************************
+void *
+readRandomPages (void *arg)
+{
+  WorkerArgs *args = (WorkerArgs *) arg;
+  int i;
+
+  waitForStart();
+  for (i = 0; i < args->numOps; i++)
+    {
+      int pageNum = rand_r(&args->seed) % args->numPages;
+      int value = -1;
+      RC rc = readPageOptimistic(args->bm, pageNum, (char *) &value, 0, sizeof(int));
+
+      // the fallback pin may find every frame pinned by the other workers
+      if (rc == RC_IM_NO_MORE_ENTRIES)
+        continue;
+      if (rc != RC_OK || value != pageNum)
+        args->errors++;
+    }
+
+  return NULL;
+}
+
+// ************************************************************
+void *
+writeOwnPages (void *arg)
+{
+  WorkerArgs *args = (WorkerArgs *) arg;
+  BM_PageHandle h;
+  int i;
+
+  memset(args->lastValue, 0, sizeof(args->lastValue));
+  waitForStart();
+  for (i = 1; i <= args->numOps; i++)
+    {
+      int slot = rand_r(&args->seed) % args->numPages;
+      RC rc = pinPage(args->bm, &h, args->firstPage + slot);
+
+      // every frame may be pinned by the other workers for a moment
+      if (rc == RC_IM_NO_MORE_ENTRIES)
+        continue;
+      if (rc != RC_OK || ((int *) h.data)[1] != args->lastValue[slot])
+        args->errors++;
+      if (rc != RC_OK)
+        continue;
+      ((int *) h.data)[1] = i;
+      args->lastValue[slot] = i;
+      markDirty(args->bm, &h);
+      unpinPage(args->bm, &h);
+    }
+
+  return NULL;
+}
+
+// ************************************************************
+void *
+latchOnePage (void *arg)
+{
+  WorkerArgs *args = (WorkerArgs *) arg;
+  BM_PageHandle h;
+
+  waitForStart();
+  if (pinPageExclusive(args->bm, &h, 2) != RC_OK || *((int *) h.data) != 2)
+    args->errors++;
+  else
+    unpinPageRef(args->bm, &h);
+  args->numOps = 1;
+
+  return NULL;
+}
+
+// ************************************************************
+// ************************************************************
+void *
+readWordsOptimistic (void *arg)
+{
+  WorkerArgs *args = (WorkerArgs *) arg;
+  int words[PAGE_SIZE / sizeof(int) - 1];
+  int i, k;
+
+  waitForStart();
+  for (i = 0; i < args->numOps; i++)
+    {
+      PageNumber pageNum = rand_r(&args->seed) % args->numPages;
+      RC rc = readPageOptimistic(args->bm, pageNum, (char *) words, sizeof(int), sizeof(words));
+
+      // the fallback pin may find every frame pinned by the other workers
+      if (rc == RC_IM_NO_MORE_ENTRIES)
+        continue;
+      if (rc != RC_OK)
+        args->errors++;
+      for (k = 1; k < PAGE_SIZE / (int) sizeof(int) - 1 && rc == RC_OK; k++)
+        if (words[k] != words[0])
+          args->errors++;
+    }
+
+  return NULL;
+}
+
+void *
+latchedReadWrite (void *arg)
+{
+  WorkerArgs *args = (WorkerArgs *) arg;
+  BM_PageHandle h;
+  int i, k;
+
+  waitForStart();
+  for (i = 1; i <= args->numOps; i++)
+    {
+      PageNumber pageNum = rand_r(&args->seed) % args->numPages;
+      int *words;
+
+      if (args->firstPage)
+        {
+          // a writer sets every word of the page but the stamp to the same value, one at a time
+          if (pinPageExclusive(args->bm, &h, pageNum) != RC_OK)
+            continue;
+          words = (int *) h.data + 1;
+          for (k = 0; k < PAGE_SIZE / (int) sizeof(int) - 1; k++)
+            words[k] = i;
+          markDirtyRef(args->bm, &h);
+        }
+      else
+        {
+          if (pinPageShared(args->bm, &h, pageNum) != RC_OK)
+            continue;
+          words = (int *) h.data + 1;
+          for (k = 1; k < 64; k++)
+            if (words[k] != words[0])
+              args->errors++;
+        }
+      unpinPageRef(args->bm, &h);
+    }
+
+  return NULL;
+}
+
+// ************************************************************
+void
+waitForStart (void)
+{
+  pthread_mutex_lock(&startLatch);
+  while (!started)
+    pthread_cond_wait(&startCond, &startLatch);
+  pthread_mutex_unlock(&startLatch);
+}
+
+// ************************************************************
+bool
+isResident (BM_BufferPool *bm, PageNumber pageNum)
+{
+  PageNumber *frameContents = getFrameContents(bm);
+  bool found = false;
+  int i;
+
+  for (i = 0; i < bm->numPages; i++)
+    if (frameContents[i] == pageNum)
+      found = true;
+  free(frameContents);
+  return found;
+}
+
+// ************************************************************
+void
+createStampedFile (char *fileName, int numPages)
+{
+  SM_FileHandle fh;
+  char page[PAGE_SIZE];
+  int i;
+
+  TEST_CHECK(createPageFile(fileName));
+  TEST_CHECK(openPageFile(fileName, &fh));
+  TEST_CHECK(ensureCapacity(numPages, &fh));
+  for (i = 0; i < numPages; i++)
+    {
+      memset(page, 0, PAGE_SIZE);
+      *((int *) page) = i;
+      TEST_CHECK(writeBlock(i, &fh, page));
+    }
+  TEST_CHECK(closePageFile(&fh));
+}
@@ -47,6 +47,17 @@ extern char *testName;
 			printf("[%s-%s-L%i-%s] OK: expected <%i> and was <%i>: %s\n",TEST_INFO, expected, real, message); \
 		} while(0)
 
+// check whether two longs are equals, e.g. the counters of BM_PoolStats
+#define ASSERT_EQUALS_LONG(expected,real,message)			\
+		do {									\
+			if ((long) (expected) != (long) (real))				\
+			{									\
+				printf("[%s-%s-L%i-%s] FAILED: expected <%ld> but was <%ld>: %s\n",TEST_INFO, (long) (expected), (long) (real), message); \
+				exit(1);							\
+			}									\
+			printf("[%s-%s-L%i-%s] OK: expected <%ld> and was <%ld>: %s\n",TEST_INFO, (long) (expected), (long) (real), message); \
+		} while(0)
+
 // check whether two ints are equals
 #define ASSERT_TRUE(real,message)					\
 		do {									\